@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>
+
+#include "eventstorage.hpp"
+#include "timerwheel.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Event waiting in the timer wheel of the notifier, periodic timers create a new event each time.
+ * Timer with an action runs it inside the dispatch of the notifier instead of publishing.
+ */
+struct DelayedEvent
+{
+    EventStorage event;
+    std::function<EventStorage()> factory;
+    std::function<void()> action;
+};
+
+using TimerHandle = TimerWheel<DelayedEvent>::Handle;
+
+}  // namespace easy
@@ -3,39 +3,159 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <inttypes.h>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 
 namespace easy
 {
 
+/**
+ * Lanes of notifier queues, queued events of higher priority are dispatched first.
+ */
+enum class Priority : uint8_t
+{
+    High,
+    Normal,
+    Low
+};
+
+constexpr auto PRIORITY_LANES = std::size_t{3};
+
 struct IEvent
 {
     using UUID_t = uint64_t;
+    using Index_t = std::size_t;
+    using Key_t = uint64_t;
 
     virtual ~IEvent() = default;
 
     virtual UUID_t uuid() const = 0;
+    virtual Index_t index() const = 0;
+    virtual Priority priority() const = 0;
+    virtual bool isConflating() const = 0;
+
+    /**
+     * Key of the topic within the event type, keyed subscribers receive only events of their topics.
+     */
+    virtual Key_t topic() const { return 0; }
+
+    /**
+     * Queued conflating event is replaced by a newer one of the same type and key.
+     * Events with distinct keys, e.g. readings of different sensors, are kept separately.
+     */
+    virtual Key_t conflationKey() const { return topic(); }
 
 protected:
-    inline static UUID_t generateUuid()
+    /**
+     * FNV-1a hash of the type signature, the same for the event type in every run and process
+     * built with the same compiler.
+     */
+    static constexpr UUID_t hashUuid(std::string_view name)
     {
-        static auto uuid = UUID_t{};
-        return ++uuid;
+        auto hash = UUID_t{14695981039346656037ull};
+        for (const auto character : name)
+        {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= UUID_t{1099511628211ull};
+        }
+        return hash;
+    }
+
+    /**
+     * Assigns dense index of the event type used to address dispatch tables. The type is identified
+     * by the address of its static, so types of the same name in anonymous namespaces of different
+     * translation units get distinct indexes. Different names with the same UUID are rejected.
+     */
+    inline static Index_t registerEvent(const void* type, UUID_t uuid, std::string_view name)
+    {
+        struct Registry
+        {
+            std::mutex accessMutex;
+            std::unordered_map<const void*, Index_t> indexes;
+            std::unordered_map<UUID_t, std::string_view> names;
+        };
+        static auto registry = Registry{};
+
+        std::lock_guard lock(registry.accessMutex);
+        auto [it, isInserted] = registry.names.try_emplace(uuid, name);
+        if (!isInserted && it->second != name)
+        {
+            throw std::logic_error("easy::IEvent: UUID collision of events " + std::string{name}
+                                   + " and " + std::string{it->second});
+        }
+        return registry.indexes.try_emplace(type, registry.indexes.size()).first->second;
     }
 };
 
-template <typename T>
+/**
+ * Event type together with a key, addresses keyed subscriptions and conflated events.
+ */
+struct EventTopic
+{
+    IEvent::Index_t eventIndex;
+    IEvent::Key_t key;
+
+    bool operator==(const EventTopic&) const = default;
+};
+
+struct EventTopicHash
+{
+    inline std::size_t operator()(const EventTopic& topic) const
+    {
+        return std::hash<IEvent::Key_t>{}(topic.key) * 31 + topic.eventIndex;
+    }
+};
+
+/**
+ * UUID of the event is computed at compile time from the type name, index is assigned during
+ * static initialization, so events must not be published before main. Routing uses the index,
+ * which is unique per type even when UUIDs are equal for types in anonymous namespaces.
+ * Priority is common for all events of the type. Type which declares
+ * static constexpr bool CONFLATING = true keeps only the latest value queued.
+ */
+template <typename T, Priority P = Priority::Normal>
 struct Event : public IEvent
 {
-    Event() { init(); }
-    static UUID_t UUID() { init(); return m_uuid; }
-    virtual UUID_t uuid() const override { return m_uuid; }
+    static constexpr UUID_t UUID() { return hashUuid(typeName()); }
+    static Index_t INDEX() { return m_index; }
+    static constexpr Priority PRIORITY() { return P; }
+    virtual UUID_t uuid() const override { return UUID(); }
+    virtual Index_t index() const override { return m_index; }
+    virtual Priority priority() const override { return P; }
+    virtual bool isConflating() const override
+    {
+        if constexpr (requires { T::CONFLATING; })
+            return T::CONFLATING;
+        return false;
+    }
 
 private:
-    inline static void init() { if (!m_uuid) m_uuid = generateUuid(); }
+    static constexpr std::string_view typeName()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
 
-    static inline UUID_t m_uuid = {};
+    static inline const char m_typeTag = {};    // its address identifies the type
+    static inline const Index_t m_index = registerEvent(&m_typeTag, UUID(), typeName());
 };
 
+/**
+ * Type declared as Event<T> itself. Types derived from an event share its UUID and index,
+ * so they are published as the base event, but cannot be subscribed separately.
+ */
+template <typename T>
+concept EventType = std::is_base_of_v<Event<T, T::PRIORITY()>, T>;
+
 }  // namespace easy
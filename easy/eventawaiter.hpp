@@ -0,0 +1,165 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <optional>
+#include <utility>
+
+#include "isubscription.hpp"
+
+
+namespace easy
+{
+
+template <typename T>
+class EventAwaiters;
+
+/**
+ * Awaitable for the next event of type T received by the notifier, returned by Notifier::next<T>().
+ * Events are awaited from the moment the awaiter is created, so it may be created before publishing
+ * a request and awaited after. The coroutine is resumed inside Notifier::dispatch().
+ */
+template <typename T>
+class EventAwaiter
+{
+    friend class EventAwaiters<T>;
+
+    struct List
+    {
+        EventAwaiter* first = nullptr;
+        EventAwaiter* last = nullptr;
+    };
+
+public:
+    explicit EventAwaiter(EventAwaiters<T>& awaiters)
+    {
+        link(awaiters.m_waiting);
+    }
+
+    ~EventAwaiter()
+    {
+        unlink();
+    }
+
+    EventAwaiter(const EventAwaiter&) = delete;
+    EventAwaiter& operator=(const EventAwaiter&) = delete;
+    EventAwaiter(EventAwaiter&&) = delete;
+    EventAwaiter& operator=(EventAwaiter&&) = delete;
+
+    bool await_ready() const noexcept { return m_event.has_value(); }
+    void await_suspend(std::coroutine_handle<> coroutine) noexcept { m_coroutine = coroutine; }
+    T await_resume() { return std::move(*m_event); }
+
+private:
+    inline void link(List& list)
+    {
+        m_list = &list;
+        m_previous = list.last;
+        (list.last ? list.last->m_next : list.first) = this;
+        list.last = this;
+    }
+
+    inline void unlink()
+    {
+        if (!m_list)
+            return;
+
+        (m_previous ? m_previous->m_next : m_list->first) = m_next;
+        (m_next ? m_next->m_previous : m_list->last) = m_previous;
+        m_list = nullptr;
+        m_previous = nullptr;
+        m_next = nullptr;
+    }
+
+    template <typename Event>
+    inline void receive(Event&& event)
+    {
+        m_event.emplace(std::forward<Event>(event));
+        if (auto coroutine = std::exchange(m_coroutine, nullptr))
+        {
+            coroutine.resume();    // may destroy the awaiter
+        }
+    }
+
+private:
+    std::optional<T> m_event;
+    std::coroutine_handle<> m_coroutine;
+    List* m_list = nullptr;
+    EventAwaiter* m_previous = nullptr;
+    EventAwaiter* m_next = nullptr;
+};
+
+
+/**
+ * Subscription of a notifier for all coroutines awaiting event T. It stays subscribed while
+ * awaiters come and go, so awaiting does not subscribe and unsubscribe the notifier each time.
+ */
+template <typename T>
+class EventAwaiters : public ISubscription
+{
+    friend class EventAwaiter<T>;
+    using List = typename EventAwaiter<T>::List;
+
+public:
+    EventAwaiters() = default;
+    EventAwaiters(const EventAwaiters&) = delete;
+    EventAwaiters& operator=(const EventAwaiters&) = delete;
+
+    ~EventAwaiters() override
+    {
+        while (m_waiting.first)
+        {
+            m_waiting.first->unlink();
+        }
+        if (m_unsubscriber)
+        {
+            m_unsubscriber();
+        }
+    }
+
+    inline void setUnsubscriber(std::function<void()> unsubscriber)
+    {
+        m_unsubscriber = std::move(unsubscriber);
+    }
+
+private:
+    void notify(const IEvent& event) override
+    {
+        deliver(static_cast<const T&>(event), false);
+    }
+
+    void notify(IEvent&& event) override
+    {
+        deliver(static_cast<T&>(event), true);
+    }
+
+    template <typename Event>
+    void deliver(Event& event, bool isExclusive)
+    {
+        auto receivers = std::exchange(m_waiting, List{});    // awaiters created by resumed coroutines wait for next event
+        for (auto awaiter = receivers.first; awaiter; awaiter = awaiter->m_next)
+        {
+            awaiter->m_list = &receivers;
+        }
+
+        while (auto awaiter = receivers.first)
+        {
+            awaiter->unlink();
+            if constexpr (!std::is_const_v<Event>)
+            {
+                if (isExclusive && !receivers.first)
+                {
+                    awaiter->receive(std::move(event));
+                    continue;
+                }
+            }
+            awaiter->receive(std::as_const(event));
+        }
+    }
+
+private:
+    List m_waiting;
+    std::function<void()> m_unsubscriber;
+};
+
+}  // namespace easy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "event.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Predicate of subscriber, evaluated by publishing threads, so it must be safe to call concurrently.
+ */
+using EventFilter = std::function<bool(const IEvent&)>;
+
+/**
+ * Filters of all subscribers of one event type. Event is accepted when any filter accepts it,
+ * subscriber without filter accepts every event.
+ */
+class EventFilters
+{
+public:
+    using Filter = std::shared_ptr<const EventFilter>;
+
+    inline void add(const Filter& filter)
+    {
+        if (filter)
+            m_filters.push_back(filter);
+        else
+            ++m_unfilteredCount;
+    }
+
+    inline void remove(const Filter& filter)
+    {
+        if (!filter)
+        {
+            --m_unfilteredCount;
+            return;
+        }
+
+        auto filterIt = std::find(m_filters.begin(), m_filters.end(), filter);
+        if (filterIt != m_filters.end())
+        {
+            m_filters.erase(filterIt);
+        }
+    }
+
+    inline void remove(const EventFilters& filters)
+    {
+        m_unfilteredCount -= filters.m_unfilteredCount;
+        for (const auto& filter : filters.m_filters)
+        {
+            remove(filter);
+        }
+    }
+
+    inline bool accepts(const IEvent& event) const
+    {
+        return m_unfilteredCount > 0 || std::any_of(m_filters.begin(), m_filters.end(), [&event](const auto& filter) {
+            return (*filter)(event);
+        });
+    }
+
+    inline bool empty() const
+    {
+        return m_unfilteredCount == 0 && m_filters.empty();
+    }
+
+private:
+    std::size_t m_unfilteredCount = 0;
+    std::vector<Filter> m_filters;
+};
+
+}  // namespace easy
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "event.hpp"
+#include "eventstorage.hpp"
+#include "poolallocator.hpp"
+#include "ringbuffer.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Queue of events split into priority lanes. Events are taken from the highest non-empty lane,
+ * in publication order within the lane. Queued conflating events are indexed by their key,
+ * so a newer event replaces the pending one in its place.
+ */
+class EventLanes
+{
+public:
+    /**
+     * Replaces the pending event of the same type and key. Returns false when the event
+     * is not conflating or no such event is queued.
+     */
+    inline bool conflate(const EventStorage& event)
+    {
+        if (!event->isConflating())
+            return false;
+
+        auto pending = m_pendingConflated.find(keyOf(*event));
+        if (pending == m_pendingConflated.end())
+            return false;
+
+        const auto lane = laneOf(event->priority());
+        m_lanes[lane][pending->second - m_popped[lane]] = event;
+        return true;
+    }
+
+    inline void push(EventStorage event)
+    {
+        const auto lane = laneOf(event->priority());
+        if (event->isConflating())
+        {
+            m_pendingConflated[keyOf(*event)] = m_popped[lane] + m_lanes[lane].size();
+        }
+        m_lanes[lane].push(std::move(event));
+        ++m_size;
+    }
+
+    inline void pop()
+    {
+        const auto lane = frontLane();
+        popFront(lane, *m_lanes[lane].front());
+    }
+
+    inline EventStorage& front()
+    {
+        return m_lanes[frontLane()].front();
+    }
+
+    inline EventStorage take()
+    {
+        const auto lane = frontLane();
+        auto event = std::move(m_lanes[lane].front());
+        popFront(lane, *event);
+        return event;
+    }
+
+    /**
+     * Drops the oldest event of the lowest priority lane, unless it has higher priority than
+     * the given one. Returns false when nothing was dropped.
+     */
+    inline bool dropOldest(Priority notAbove)
+    {
+        for (auto lane = PRIORITY_LANES; lane-- > laneOf(notAbove);)
+        {
+            if (!m_lanes[lane].empty())
+            {
+                popFront(lane, *m_lanes[lane].front());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+    inline bool empty() const
+    {
+        return m_size == 0;
+    }
+
+private:
+    using PendingEvents = std::unordered_map<EventTopic, std::size_t, EventTopicHash, std::equal_to<>,
+                                             PoolAllocator<std::pair<const EventTopic, std::size_t>>>;
+
+    static constexpr std::size_t laneOf(Priority priority)
+    {
+        return static_cast<std::size_t>(priority);
+    }
+
+    static inline EventTopic keyOf(const IEvent& event)
+    {
+        return EventTopic{event.index(), event.conflationKey()};
+    }
+
+    inline std::size_t frontLane() const
+    {
+        auto lane = std::size_t{};
+        while (m_lanes[lane].empty())
+        {
+            ++lane;
+        }
+        return lane;
+    }
+
+    inline void popFront(std::size_t lane, const IEvent& front)
+    {
+        if (front.isConflating())
+        {
+            m_pendingConflated.erase(keyOf(front));
+        }
+        m_lanes[lane].pop();
+        ++m_popped[lane];
+        --m_size;
+    }
+
+private:
+    std::array<RingBuffer<EventStorage>, PRIORITY_LANES> m_lanes;
+    std::array<std::size_t, PRIORITY_LANES> m_popped = {};    // position of lane front since creation
+    std::size_t m_size = 0;
+    PendingEvents m_pendingConflated;    // conflation key to position of queued event in its lane
+};
+
+}  // namespace easy
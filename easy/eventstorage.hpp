@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "event.hpp"
+#include "poolallocator.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Owns a queued event. Small events are copied into the inline buffer, so queues keep them
+ * in their own slots without heap allocation. Larger events are allocated from the pool once
+ * and shared between queues.
+ */
+class EventStorage
+{
+public:
+    static constexpr auto INLINE_SIZE = 3 * sizeof(void*);
+    static constexpr auto INLINE_ALIGNMENT = alignof(void*);
+
+    template <typename T>
+    static constexpr bool isStoredInline = sizeof(T) <= INLINE_SIZE && alignof(T) <= INLINE_ALIGNMENT
+                                           && std::is_nothrow_copy_constructible_v<T>
+                                           && std::is_nothrow_move_constructible_v<T>;
+
+private:
+    struct Operations
+    {
+        IEvent* (*copy)(const void* from, void* to);
+        IEvent* (*relocate)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename T>
+    static constexpr auto INLINE_OPERATIONS = Operations{
+        [](const void* from, void* to) -> IEvent* {
+            return new (to) T(*static_cast<const T*>(from));
+        },
+        [](void* from, void* to) -> IEvent* {
+            auto event = new (to) T(std::move(*static_cast<T*>(from)));
+            static_cast<T*>(from)->~T();
+            return event;
+        },
+        [](void* storage) { static_cast<T*>(storage)->~T(); }
+    };
+
+    using SharedEvent = std::shared_ptr<IEvent>;
+    static constexpr auto SHARED_OPERATIONS = Operations{
+        [](const void* from, void* to) -> IEvent* {
+            return (new (to) SharedEvent(*static_cast<const SharedEvent*>(from)))->get();
+        },
+        [](void* from, void* to) -> IEvent* {
+            auto event = new (to) SharedEvent(std::move(*static_cast<SharedEvent*>(from)));
+            static_cast<SharedEvent*>(from)->~SharedEvent();
+            return event->get();
+        },
+        [](void* storage) { static_cast<SharedEvent*>(storage)->~SharedEvent(); }
+    };
+
+public:
+    EventStorage() = default;
+
+    template <typename T, typename Event_t = std::remove_cvref_t<T>,
+              typename = std::enable_if_t<std::is_base_of_v<IEvent, Event_t>>>
+    explicit EventStorage(T&& event)
+        : EventStorage(std::in_place_type<Event_t>, std::forward<T>(event))
+    {}
+
+    template <typename T, typename... Args>
+    explicit EventStorage(std::in_place_type_t<T>, Args&&... args)
+    {
+        static_assert(std::is_base_of_v<IEvent, T>, "Stored type must inherit from easy::Event");
+        if constexpr (isStoredInline<T>)
+        {
+            m_event = new (m_buffer) T(std::forward<Args>(args)...);
+            m_operations = &INLINE_OPERATIONS<T>;
+        }
+        else
+        {
+            m_event = (new (m_buffer) SharedEvent(std::allocate_shared<T>(PoolAllocator<T>{},
+                                                                         std::forward<Args>(args)...)))->get();
+            m_operations = &SHARED_OPERATIONS;
+        }
+    }
+
+    EventStorage(const EventStorage& other)
+    {
+        if (other.m_operations)
+        {
+            m_event = other.m_operations->copy(other.m_buffer, m_buffer);
+            m_operations = other.m_operations;
+        }
+    }
+
+    EventStorage(EventStorage&& other) noexcept
+    {
+        takeFrom(other);
+    }
+
+    EventStorage& operator=(const EventStorage& other)
+    {
+        if (this != &other)
+        {
+            *this = EventStorage(other);
+        }
+        return *this;
+    }
+
+    EventStorage& operator=(EventStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~EventStorage()
+    {
+        reset();
+    }
+
+    inline void reset()
+    {
+        if (m_operations)
+        {
+            m_operations->destroy(m_buffer);
+            m_operations = nullptr;
+            m_event = nullptr;
+        }
+    }
+
+    inline bool isInline() const
+    {
+        return m_operations && m_operations != &SHARED_OPERATIONS;
+    }
+
+    /**
+     * True when no other storage refers to the event, so its content may be moved out.
+     * use_count() is a relaxed load, the fence orders reads done by other threads through
+     * their already released copies before the caller mutates the event.
+     */
+    inline bool isExclusive() const
+    {
+        if (m_operations != &SHARED_OPERATIONS)
+            return m_operations != nullptr;
+
+        if (std::launder(reinterpret_cast<const SharedEvent*>(m_buffer))->use_count() != 1)
+            return false;
+        std::atomic_thread_fence(std::memory_order_acquire);    // pairs with release of the last other copy
+        return true;
+    }
+
+    inline IEvent* get() const { return m_event; }
+    inline IEvent& operator*() const { return *m_event; }
+    inline IEvent* operator->() const { return m_event; }
+    inline explicit operator bool() const { return m_event != nullptr; }
+
+private:
+    inline void takeFrom(EventStorage& other) noexcept
+    {
+        if (other.m_operations)
+        {
+            m_event = other.m_operations->relocate(other.m_buffer, m_buffer);
+            m_operations = other.m_operations;
+            other.m_operations = nullptr;
+            other.m_event = nullptr;
+        }
+    }
+
+private:
+    alignas(INLINE_ALIGNMENT) std::byte m_buffer[INLINE_SIZE];
+    IEvent* m_event = nullptr;
+    const Operations* m_operations = nullptr;
+};
+
+}  // namespace easy
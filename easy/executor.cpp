@@ -0,0 +1,171 @@
+#include "executor.hpp"
+
+#include "strand.hpp"
+
+
+namespace easy
+{
+
+namespace
+{
+
+thread_local Executor* currentExecutor = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+}  // namespace
+
+
+Executor::Executor(std::size_t workersCount)
+{
+    for (auto i = std::size_t{}; i < std::max(workersCount, std::size_t{1}); ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (auto i = std::size_t{}; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->thread = std::thread([this, i]() { work(i); });
+    }
+}
+
+Executor::~Executor()
+{
+    m_isStopping.store(true);
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_sleepCondition.notify_all();
+    }
+
+    for (auto& worker : m_workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+std::size_t Executor::workersCount() const
+{
+    return m_workers.size();
+}
+
+void Executor::schedule(Strand& strand)
+{
+    m_readyStrands.fetch_add(1);
+    if (currentExecutor == this)
+    {
+        auto& worker = *m_workers[currentWorker];
+        std::lock_guard lock(worker.queueMutex);
+        worker.readyStrands.push(&strand);
+    }
+    else
+    {
+        std::lock_guard lock(m_injectedMutex);
+        m_injectedStrands.push(&strand);
+    }
+
+    if (m_sleepingWorkers.load() > 0)    // pairs with increment before worker falls asleep
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_sleepCondition.notify_one();
+    }
+}
+
+void Executor::scheduleAt(Strand& strand, std::chrono::steady_clock::time_point time)
+{
+    {
+        std::lock_guard lock(m_timersMutex);
+        if (m_timers.emplace(time, &strand) != m_timers.begin())
+            return;    // sleeping workers already wake up earlier
+        m_timersVersion.fetch_add(1);
+    }
+
+    if (m_sleepingWorkers.load() > 0)    // pairs with increment before worker falls asleep
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_sleepCondition.notify_all();
+    }
+}
+
+void Executor::unschedule(Strand& strand)
+{
+    std::lock_guard lock(m_timersMutex);
+    std::erase_if(m_timers, [&strand](const auto& timer) { return timer.second == &strand; });
+}
+
+std::optional<std::chrono::steady_clock::time_point> Executor::scheduleExpired()
+{
+    std::lock_guard lock(m_timersMutex);    // keeps strand alive until unscheduled
+    const auto now = std::chrono::steady_clock::now();
+    while (!m_timers.empty() && m_timers.begin()->first <= now)
+    {
+        auto& strand = *m_timers.begin()->second;
+        m_timers.erase(m_timers.begin());
+        strand.schedule();
+    }
+
+    if (m_timers.empty())
+        return std::nullopt;
+    return m_timers.begin()->first;
+}
+
+void Executor::work(std::size_t workerIndex)
+{
+    currentExecutor = this;
+    currentWorker = workerIndex;
+
+    while (!m_isStopping.load())
+    {
+        const auto timersVersion = m_timersVersion.load();
+        const auto wakeUpTime = scheduleExpired();
+        if (auto strand = take(workerIndex))
+        {
+            strand->run();
+            continue;
+        }
+
+        m_sleepingWorkers.fetch_add(1);
+        {
+            auto isAwake = [this, timersVersion]() {
+                return m_readyStrands.load() > 0 || m_timersVersion.load() != timersVersion || m_isStopping.load();
+            };
+            std::unique_lock lock(m_sleepMutex);
+            if (wakeUpTime)
+                m_sleepCondition.wait_until(lock, *wakeUpTime, isAwake);
+            else
+                m_sleepCondition.wait(lock, isAwake);
+        }
+        m_sleepingWorkers.fetch_sub(1);
+    }
+}
+
+Strand* Executor::take(std::size_t workerIndex)
+{
+    auto strand = pop(m_workers[workerIndex]->queueMutex, m_workers[workerIndex]->readyStrands);
+    if (!strand)
+    {
+        strand = pop(m_injectedMutex, m_injectedStrands);
+    }
+    for (auto i = std::size_t{1}; !strand && i < m_workers.size(); ++i)    // steal from other workers
+    {
+        auto& victim = *m_workers[(workerIndex + i) % m_workers.size()];
+        strand = pop(victim.queueMutex, victim.readyStrands);
+    }
+
+    if (strand)
+    {
+        m_readyStrands.fetch_sub(1);
+    }
+    return strand;
+}
+
+Strand* Executor::pop(std::mutex& queueMutex, RingBuffer<Strand*>& strands)
+{
+    std::lock_guard lock(queueMutex);
+    if (strands.empty())
+        return nullptr;
+
+    auto strand = strands.front();
+    strands.pop();
+    return strand;
+}
+
+}  // namespace easy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ringbuffer.hpp"
+
+
+namespace easy
+{
+
+class Strand;
+
+/**
+ * Pool of worker threads running strands. Strands scheduled by a worker go to its own queue,
+ * strands scheduled by other threads to the shared one, and idle workers steal from the others.
+ * Strands waiting for timers of their notifiers are scheduled by the first worker awake after the deadline.
+ */
+class Executor
+{
+    friend class Strand;
+
+public:
+    explicit Executor(std::size_t workersCount = std::max(1u, std::thread::hardware_concurrency()));
+    ~Executor();
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(Executor&&) = delete;
+
+    std::size_t workersCount() const;
+
+private:
+    struct Worker
+    {
+        std::mutex queueMutex;
+        RingBuffer<Strand*> readyStrands;
+        std::thread thread;
+    };
+
+    void schedule(Strand& strand);
+    void scheduleAt(Strand& strand, std::chrono::steady_clock::time_point time);
+    void unschedule(Strand& strand);
+    std::optional<std::chrono::steady_clock::time_point> scheduleExpired();
+    void work(std::size_t workerIndex);
+    Strand* take(std::size_t workerIndex);
+    static Strand* pop(std::mutex& queueMutex, RingBuffer<Strand*>& strands);
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::mutex m_injectedMutex;
+    RingBuffer<Strand*> m_injectedStrands;
+    std::mutex m_timersMutex;
+    std::multimap<std::chrono::steady_clock::time_point, Strand*> m_timers;
+    std::atomic<std::size_t> m_timersVersion = 0;    // wakes sleeping workers when an earlier deadline arrives
+
+    std::atomic<std::size_t> m_readyStrands = 0;
+    std::atomic<std::size_t> m_sleepingWorkers = 0;
+    std::atomic_bool m_isStopping = false;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+};
+
+}  // namespace easy
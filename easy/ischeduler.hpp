@@ -0,0 +1,17 @@
+#pragma once
+
+
+namespace easy
+{
+
+/**
+ * Runs notifiers of a thread context which is not bound to a thread, see easy::Strand.
+ */
+class IScheduler
+{
+public:
+    virtual ~IScheduler() = default;
+    virtual void schedule() = 0;    // called by publishers when events arrive to the context
+};
+
+}  // namespace easy
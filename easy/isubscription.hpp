@@ -14,6 +14,7 @@ class ISubscription
 public:
     virtual ~ISubscription() = default;
     virtual void notify(const IEvent& event) = 0;
+    virtual void notify(IEvent&& event) { notify(static_cast<const IEvent&>(event)); }
 };
 
 }  // namespace easy
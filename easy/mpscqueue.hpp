@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "poolallocator.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Lock-free multi-producer/single-consumer queue.
+ * Producers link new nodes onto an atomic head, the single consumer takes
+ * the whole chain at once and walks it in publication (FIFO) order.
+ */
+template <typename T>
+class MpscQueue
+{
+private:
+    struct Node
+    {
+        T value;
+        Node* next;
+    };
+
+    using NodesPool = MemoryPool<sizeof(Node), alignof(Node)>;
+
+    static inline Node* createNode(T&& value, Node* next)
+    {
+        return new (NodesPool::allocate()) Node{std::move(value), next};
+    }
+
+    static inline void destroyNode(Node* node)
+    {
+        node->~Node();
+        NodesPool::deallocate(node);
+    }
+
+public:
+    /**
+     * Chain of values prepared by a single producer, pushed to the queue at once.
+     */
+    class Batch
+    {
+        friend class MpscQueue<T>;
+
+    public:
+        Batch() = default;
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch(Batch&& batch)
+            : m_newest{std::exchange(batch.m_newest, nullptr)}
+            , m_oldest{std::exchange(batch.m_oldest, nullptr)}
+        {}
+        Batch& operator=(Batch&& batch)
+        {
+            std::swap(m_newest, batch.m_newest);
+            std::swap(m_oldest, batch.m_oldest);
+            return *this;
+        }
+
+        ~Batch()
+        {
+            while (m_newest)
+            {
+                destroyNode(std::exchange(m_newest, m_newest->next));
+            }
+        }
+
+        inline void push(T value)
+        {
+            m_newest = createNode(std::move(value), m_newest);
+            if (!m_oldest)
+            {
+                m_oldest = m_newest;
+            }
+        }
+
+        inline bool empty() const
+        {
+            return m_newest == nullptr;
+        }
+
+    private:
+        Node* m_newest{nullptr};
+        Node* m_oldest{nullptr};
+    };
+
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    ~MpscQueue()
+    {
+        consume([](T&&) {});
+    }
+
+    inline void push(T value)
+    {
+        auto node = createNode(std::move(value), m_head.load(std::memory_order_relaxed));
+        while (!m_head.compare_exchange_weak(node->next, node,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    inline void push(Batch batch)
+    {
+        if (batch.empty())
+            return;
+
+        auto newest = std::exchange(batch.m_newest, nullptr);
+        auto oldest = std::exchange(batch.m_oldest, nullptr);
+        oldest->next = m_head.load(std::memory_order_relaxed);
+        while (!m_head.compare_exchange_weak(oldest->next, newest,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    template <typename Function>
+    inline std::size_t consume(Function&& function)
+    {
+        return consume(std::forward<Function>(function), std::numeric_limits<std::size_t>::max());
+    }
+
+    /**
+     * Passes only the newest maxConsumed values to the function, older values are discarded.
+     * Returns number of values taken from the queue.
+     */
+    template <typename Function>
+    inline std::size_t consume(Function&& function, std::size_t maxConsumed)
+    {
+        if (empty())
+            return 0;
+
+        auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        Node* first = nullptr;
+        auto taken = std::size_t{};
+        while (node)
+        {
+            auto next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+            ++taken;
+        }
+
+        for (auto discarded = taken > maxConsumed ? taken - maxConsumed : 0; discarded > 0; --discarded)
+        {
+            destroyNode(std::exchange(first, first->next));
+        }
+
+        while (first)
+        {
+            auto next = first->next;
+            function(std::move(first->value));
+            destroyNode(first);
+            first = next;
+        }
+        return taken;
+    }
+
+    inline bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    std::atomic<Node*> m_head{nullptr};
+};
+
+}  // namespace easy
@@ -3,48 +3,306 @@
  */
 #include "notifier.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
 #include "notifierpool.hpp"
+#include "strand.hpp"
 
 
 namespace easy
 {
 
+namespace
+{
+
+/**
+ * Subscriptions are taken from the table on every step, as it may grow during notify.
+ */
+template <typename Subscriptions>
+void notifySubscribers(Subscriptions&& subscriptions, std::size_t subscribersCount, EventStorage& event,
+                       bool isExclusive)
+{
+    for (auto i = std::size_t{}; i < subscribersCount; ++i)
+    {
+        const auto& entry = subscriptions()[i];
+        const auto subscriber = entry.subscription;
+        if (!subscriber || (entry.filter && !(*entry.filter)(*event)))
+            continue;
+
+        if (isExclusive && i + 1 == subscribersCount)
+        {
+            subscriber->notify(std::move(*event));    // last subscriber owns the event
+            break;
+        }
+        subscriber->notify(*event);
+    }
+}
+
+}  // namespace
+
+
 Notifier::Notifier()
     : m_uuid{getNextUuid()}
     , m_proxy{NotifiersPool::setup()}
 {}
 
+Notifier::Notifier(QueueLimit limit)
+    : Notifier()
+{
+    if (limit.policy == OverflowPolicy::Block)
+    {
+        throw std::invalid_argument("easy::Notifier: Block overflow policy is available only for thread queue");
+    }
+    m_proxy.setLimit(m_uuid, limit);
+}
+
+Notifier::Notifier(Strand& strand)
+    : m_uuid{getNextUuid()}
+    , m_proxy{NotifiersPool::setup(strand.m_context)}
+    , m_strand{&strand}
+{
+    strand.attach(*this);
+}
+
 Notifier::~Notifier()
 {
-    NotifiersPool::teardown();
+    m_awaiters.clear();
+    if (m_strand)
+    {
+        m_strand->detach(*this);
+    }
+    m_proxy.release(m_uuid);
+    NotifiersPool::teardown(m_proxy.context());
 }
 
 bool Notifier::dispatch()
+{
+    return dispatch(1) != 0;
+}
+
+std::size_t Notifier::dispatch(std::size_t maxEvents)
+{
+    return dispatch(maxEvents, std::nullopt);
+}
+
+std::size_t Notifier::dispatchAll()
+{
+    return dispatch(std::numeric_limits<std::size_t>::max(), std::nullopt);
+}
+
+std::size_t Notifier::dispatch(std::size_t maxEvents, std::optional<std::chrono::steady_clock::time_point> deadline)
 {
     if (m_dispatchRecursionBarrier)
-        return false;
+        return 0;
     m_dispatchRecursionBarrier = true;
 
-    if (auto event = m_proxy.pull(m_uuid))
+    publishExpiredEvents();
+
+    auto& events = m_proxy.pull(m_uuid);
+    auto dispatched = std::size_t{};
+    auto processed = std::size_t{};
+
+    while (dispatched < maxEvents && !events.empty())
     {
-        auto it = m_subscriptions.find(event->uuid());
-        if (it != m_subscriptions.end())
+        if (deadline && processed++ % DEADLINE_CHECK_INTERVAL == 0
+            && std::chrono::steady_clock::now() >= *deadline)
         {
-            for (auto subscriber : it->second)
-            {
-                subscriber->notify(*event);
-            }
+            break;
         }
-        m_dispatchRecursionBarrier = false;
-        return true;
+
+        auto event = events.take();
+
+        const auto eventIndex = event->index();
+        auto topicSubscriptions = m_topicSubscriptions.empty() ? nullptr
+                                                               : findSubscriptions(eventIndex, event->topic());
+        // new subscribers wait for next event
+        const auto subscribersCount = eventIndex < m_subscriptions.size() ? m_subscriptions[eventIndex].size() : 0;
+        const auto topicSubscribersCount = topicSubscriptions ? topicSubscriptions->size() : 0;
+        if (subscribersCount == 0 && topicSubscribersCount == 0)
+            continue;    // unsubscribed while event was queued
+
+        const auto isExclusive = event.isExclusive();
+        notifySubscribers([this, eventIndex]() -> SubscriptionsList& { return m_subscriptions[eventIndex]; },
+                          subscribersCount, event, isExclusive && topicSubscribersCount == 0);
+        notifySubscribers([topicSubscriptions]() -> SubscriptionsList& { return *topicSubscriptions; },
+                          topicSubscribersCount, event, isExclusive);
+        ++dispatched;
     }
+
     m_dispatchRecursionBarrier = false;
-    return false;
+    removePendingSubscriptions();
+    return dispatched;
+}
+
+std::size_t Notifier::waitAndDispatch()
+{
+    return waitAndDispatch(std::nullopt);
+}
+
+std::size_t Notifier::waitAndDispatch(std::optional<std::chrono::steady_clock::time_point> deadline)
+{
+    if (m_dispatchRecursionBarrier)
+        return 0;
+
+    if (m_strand)
+    {
+        throw std::logic_error("easy::Notifier: notifier bound to strand is dispatched by executor");
+    }
+
+    while (true)
+    {
+        if (auto dispatched = dispatchAll())
+            return dispatched;
+
+        auto wakeUpTime = nextTimerExpiry();    // timers are serviced while waiting for events
+        if (!wakeUpTime || (deadline && *deadline < *wakeUpTime))
+        {
+            wakeUpTime = deadline;
+        }
+
+        if (!NotifiersPool::wait(m_proxy.context(), wakeUpTime)
+            && deadline && std::chrono::steady_clock::now() >= *deadline)
+        {
+            return dispatchAll();
+        }
+    }
+}
+
+bool Notifier::cancel(TimerHandle timer)
+{
+    return m_timers.cancel(timer);
+}
+
+TimerHandle Notifier::schedule(std::chrono::steady_clock::time_point time, DelayedEvent event,
+                               std::chrono::milliseconds period)
+{
+    using Tick = TimerWheel<DelayedEvent>::Tick;
+
+    if (event.factory && period.count() <= 0)
+    {
+        throw std::invalid_argument("easy::Notifier: interval of periodic events must be positive");
+    }
+    const auto periodTicks = static_cast<Tick>(std::max(period, std::chrono::milliseconds{}).count());
+    auto timer = m_timers.insert(timerTick(time), std::move(event), periodTicks);
+    if (m_strand)
+    {
+        m_strand->scheduleAt(*nextTimerExpiry());
+    }
+    return timer;
+}
+
+TimerWheel<DelayedEvent>::Tick Notifier::timerTick(std::chrono::steady_clock::time_point time) const
+{
+    const auto tick = std::chrono::ceil<std::chrono::milliseconds>(time - m_timersEpoch).count();
+    return static_cast<TimerWheel<DelayedEvent>::Tick>(std::max<decltype(tick)>(tick, 0));
+}
+
+void Notifier::publishExpiredEvents()
+{
+    if (m_timers.empty())
+        return;
+
+    const auto now = std::chrono::floor<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_timersEpoch);
+    m_timers.advance(static_cast<TimerWheel<DelayedEvent>::Tick>(now.count()), [this](DelayedEvent& timer) {
+        if (timer.action)
+            timer.action();
+        else
+            m_proxy.push(m_uuid, timer.factory ? timer.factory() : std::move(timer.event));
+    });
+}
+
+std::optional<std::chrono::steady_clock::time_point> Notifier::nextTimerExpiry() const
+{
+    if (auto tick = m_timers.nextExpiry())
+        return m_timersEpoch + std::chrono::milliseconds(*tick);
+    return std::nullopt;
+}
+
+Notifier::SubscriptionsList& Notifier::subscriptionsOf(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic)
+{
+    if (topic)
+    {
+        return m_topicSubscriptions[EventTopic{eventIndex, *topic}];
+    }
+
+    if (eventIndex >= m_subscriptions.size())
+    {
+        m_subscriptions.resize(eventIndex + 1);
+    }
+    return m_subscriptions[eventIndex];
+}
+
+Notifier::SubscriptionsList* Notifier::findSubscriptions(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic)
+{
+    if (topic)
+    {
+        auto topicIt = m_topicSubscriptions.find(EventTopic{eventIndex, *topic});
+        return topicIt != m_topicSubscriptions.end() ? &topicIt->second : nullptr;
+    }
+    return eventIndex < m_subscriptions.size() ? &m_subscriptions[eventIndex] : nullptr;
+}
+
+void Notifier::unsubscribe(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                           SubscriptionsList::Handle handle)
+{
+    auto subscriptions = findSubscriptions(eventIndex, topic);
+    if (!subscriptions)
+        return;
+
+    auto subscriber = subscriptions->find(handle);
+    if (!subscriber)
+        return;
+
+    if (m_dispatchRecursionBarrier)    // subscribers list is iterated, remove it after dispatch
+    {
+        subscriber->subscription = nullptr;
+        m_pendingUnsubscriptions.emplace_back(eventIndex, topic, handle);
+        return;
+    }
+
+    const auto filter = std::move(subscriber->filter);
+    subscriptions->eraseOrdered(handle);    // subscribers are notified in subscription order
+    if (topic && subscriptions->empty())
+    {
+        m_topicSubscriptions.erase(EventTopic{eventIndex, *topic});
+    }
+    m_proxy.unsubscribe(m_uuid, eventIndex, topic, filter);
+}
+
+void Notifier::removePendingSubscriptions()
+{
+    for (const auto& [eventIndex, topic, handle] : m_pendingUnsubscriptions)
+    {
+        unsubscribe(eventIndex, topic, handle);
+    }
+    m_pendingUnsubscriptions.clear();
+}
+
+void Notifier::setThreadQueueLimit(QueueLimit limit)
+{
+    NotifiersPool::setLimit(m_proxy.context(), limit);
+}
+
+std::size_t Notifier::droppedEvents() const
+{
+    return m_proxy.droppedEvents(m_uuid);
+}
+
+std::size_t Notifier::droppedThreadEvents() const
+{
+    return NotifiersPool::droppedEvents(m_proxy.context());
+}
+
+std::size_t Notifier::queuedThreadEvents() const
+{
+    return NotifiersPool::queuedEvents(m_proxy.context());
 }
 
 Notifier::UUID_t Notifier::getNextUuid()
 {
-    static UUID_t uuid = 0;
+    static std::atomic<UUID_t> uuid = 0;    // notifiers of strands are created by executor workers
     return ++uuid;
 }
 
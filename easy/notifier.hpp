@@ -3,68 +3,373 @@
  */
 #pragma once
 
+#include <chrono>
 #include <functional>
-#include <map>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
+#include "delayedevent.hpp"
+#include "eventawaiter.hpp"
+#include "eventfilters.hpp"
+#include "eventstorage.hpp"
 #include "notifierproxy.hpp"
 #include "isubscription.hpp"
-#include "doubleendedlinkedlist.hpp"
+#include "queuelimit.hpp"
+#include "request.hpp"
+#include "slotmap.hpp"
+#include "timerwheel.hpp"
 
 
 namespace easy
 {
 
+class Strand;
+
 class Notifier
 {
     friend class ISubscription;
+    friend class Strand;
+
+    struct Subscriber
+    {
+        ISubscription* subscription;
+        EventFilters::Filter filter;
+    };
 
-    using SubscriptionsList = DoubleEndedLinkedList<ISubscription*>;
+    using SubscriptionsList = SlotMap<Subscriber>;
     using UUID_t = uint64_t;
 
 public:
+    static constexpr auto DEADLINE_CHECK_INTERVAL = std::size_t{8};
+
     Notifier();
+    explicit Notifier(QueueLimit limit);
+
+    /**
+     * Notifier dispatched by the strand's executor, instead of the thread which created it.
+     */
+    explicit Notifier(Strand& strand);
     ~Notifier();
     Notifier(const Notifier&) = delete;
     Notifier& operator=(const Notifier&) = delete;
     Notifier(Notifier&&) = delete;
     Notifier& operator=(Notifier&&) = delete;
 
+    /**
+     * Subscriber with filter receives only events accepted by it. Events from other threads
+     * are filtered by publishers, so the filter must be safe to call from any thread.
+     */
+    template <typename T>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    std::function<void()>> subscribe(ISubscription* subscriber, std::function<bool(const T&)> filter = {})
+    {
+        return addSubscription<T>(subscriber, std::nullopt, std::move(filter));
+    }
+
+    /**
+     * Subscribes only for events of type T with the given topic() key.
+     */
+    template <typename T>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    std::function<void()>> subscribe(ISubscription* subscriber, IEvent::Key_t topic,
+                                     std::function<bool(const T&)> filter = {})
+    {
+        return addSubscription<T>(subscriber, topic, std::move(filter));
+    }
+
+    /**
+     * Awaitable for the next event of type T, to be co_awaited by a coroutine, e.g. easy::Task.
+     */
+    template <typename T>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    EventAwaiter<T>> next()
+    {
+        static_assert(std::is_copy_constructible_v<T>, "Awaited event must be copyable");
+        return EventAwaiter<T>(awaitersOf<T, EventAwaiters<T>>(std::nullopt));
+    }
+
+    /**
+     * Publishes Request<T> and returns awaitable for the first reply R to it. The reply is sent
+     * only to this notifier, so many requests may be outstanding at once without broadcasting replies.
+     * Request rejected by a full queue completes at once without reply.
+     */
+    template <typename R, typename T>
+    std::enable_if_t<std::is_base_of_v<IEvent, R> && std::is_base_of_v<IEvent, T>,
+    ReplyAwaiter<R>> request(T event)
+    {
+        return sendRequest<R>(std::move(event), std::nullopt);
+    }
+
+    /**
+     * Awaiting gives std::nullopt when no reply arrives before the timeout, serviced like delayed events.
+     */
+    template <typename R, typename T, typename Rep, typename Period>
+    std::enable_if_t<std::is_base_of_v<IEvent, R> && std::is_base_of_v<IEvent, T>,
+    ReplyAwaiter<R>> request(T event, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return sendRequest<R>(std::move(event), std::chrono::steady_clock::now()
+                                                + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout));
+    }
+
+    /**
+     * Sends the reply only to the notifier which published the request.
+     */
+    template <typename R, typename T>
+    std::enable_if_t<std::is_base_of_v<IEvent, R>,
+    PublishStatus> reply(const Request<T>& request, R event)
+    {
+        return m_proxy.push(m_uuid, EventStorage(std::in_place_type<Reply<R>>, std::move(event),
+                                                 request.requester, request.correlationId));
+    }
+
     template <typename T>
     std::enable_if_t<std::is_base_of_v<IEvent, T>,
-    std::function<void()>> subscribe(ISubscription* subscriber)
+    PublishStatus> publish(T event)
     {
-        const auto eventId = T::UUID();
-        if (!m_subscriptions.contains(eventId))
+        return m_proxy.push(m_uuid, EventStorage(std::move(event)));
+    }
+
+    /**
+     * Constructs the event from arguments directly in the storage which is queued.
+     */
+    template <typename T, typename... Args>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    PublishStatus> emplace(Args&&... args)
+    {
+        return m_proxy.push(m_uuid, EventStorage(std::in_place_type<T>, std::forward<Args>(args)...));
+    }
+
+    /**
+     * Publishes the event when the delay elapses. Timers are serviced by dispatch of the notifier,
+     * so the event is published by the first dispatch after the time, with millisecond resolution.
+     * Notifier bound to strand is dispatched by the executor when its timers expire.
+     */
+    template <typename T, typename Rep, typename Period>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    TimerHandle> publishAfter(const std::chrono::duration<Rep, Period>& delay, T event)
+    {
+        const auto time = std::chrono::steady_clock::now()
+                        + std::chrono::ceil<std::chrono::steady_clock::duration>(delay);
+        return schedule(time, DelayedEvent{EventStorage(std::move(event))});
+    }
+
+    template <typename T, typename Clock, typename Duration>
+    std::enable_if_t<std::is_base_of_v<IEvent, T>,
+    TimerHandle> publishAt(const std::chrono::time_point<Clock, Duration>& time, T event)
+    {
+        if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>)
         {
-            m_proxy.subscribe(m_uuid, eventId);
+            return schedule(std::chrono::ceil<std::chrono::steady_clock::duration>(time),
+                            DelayedEvent{EventStorage(std::move(event))});
+        }
+        else
+        {
+            return publishAfter(time - Clock::now(), std::move(event));
         }
-        auto item = m_subscriptions[eventId].append(subscriber);
-        return [item = std::move(item), eventId, this]() {
-            m_subscriptions[eventId].remove(item);
-            if (m_subscriptions[eventId].empty())
-            {
-                m_proxy.unsubscribe(m_uuid, eventId);
-                m_subscriptions.erase(eventId);
-            }
-        };
     }
 
-    template <typename T>
+    /**
+     * Publishes event created by the factory every interval, the first one after the interval.
+     * Events are due at fixed rate from the start, so late dispatches do not shift the schedule,
+     * intervals missed entirely are skipped instead of published in a burst. The interval is rounded up
+     * to whole milliseconds, the resolution of the timers.
+     */
+    template <typename Rep, typename Period, typename Factory,
+              typename T = std::remove_cvref_t<std::invoke_result_t<Factory&>>>
     std::enable_if_t<std::is_base_of_v<IEvent, T>,
-    void> publish(T event)
+    TimerHandle> publishEvery(const std::chrono::duration<Rep, Period>& interval, Factory factory)
     {
-        m_proxy.push(m_uuid, std::make_shared<T>(std::move(event)));
+        const auto period = std::chrono::ceil<std::chrono::milliseconds>(interval);
+        return schedule(std::chrono::steady_clock::now() + period,
+                        DelayedEvent{{}, [factory = std::move(factory)]() mutable { return EventStorage(factory()); }},
+                        period);
+    }
+
+    /**
+     * Cancels event which is not published yet or stops periodic events,
+     * returns false when the event is already published or cancelled.
+     */
+    bool cancel(TimerHandle timer);
+
+    /**
+     * Publishes all events from the range at once, range may hold events of a single type
+     * or std::variant of event types for heterogeneous batches.
+     */
+    template <typename Range>
+    std::enable_if_t<std::ranges::input_range<Range>,
+    PublishStatus> publishBatch(Range&& events)
+    {
+        auto batch = std::vector<EventStorage>{};
+        if constexpr (std::ranges::sized_range<Range>)
+        {
+            batch.reserve(std::ranges::size(events));
+        }
+
+        for (auto&& event : events)
+        {
+            if constexpr (std::is_lvalue_reference_v<Range>)
+                batch.push_back(makeEvent(event));
+            else
+                batch.push_back(makeEvent(std::move(event)));
+        }
+        return m_proxy.push(m_uuid, std::move(batch));
     }
 
     bool dispatch();
+    std::size_t dispatch(std::size_t maxEvents);
+    std::size_t dispatchAll();
+
+    /**
+     * Dispatches queued events until the queue is empty or the deadline is reached,
+     * the clock is checked once per DEADLINE_CHECK_INTERVAL events.
+     */
+    template <typename Rep, typename Period>
+    std::size_t dispatchFor(const std::chrono::duration<Rep, Period>& duration)
+    {
+        return dispatchUntil(std::chrono::steady_clock::now()
+                           + std::chrono::ceil<std::chrono::steady_clock::duration>(duration));
+    }
+
+    template <typename Clock, typename Duration>
+    std::size_t dispatchUntil(const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>)
+        {
+            return dispatch(std::numeric_limits<std::size_t>::max(),
+                            std::chrono::ceil<std::chrono::steady_clock::duration>(deadline));
+        }
+        else
+        {
+            return dispatchFor(deadline - Clock::now());
+        }
+    }
+
+    /**
+     * Blocks the thread until events for the notifier arrive and dispatches all of them.
+     * Returns number of dispatched events, 0 when the timeout expired.
+     * Delayed events of the notifier are published while it waits.
+     */
+    std::size_t waitAndDispatch();
+
+    template <typename Rep, typename Period>
+    std::size_t dispatchWait(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now()
+                            + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+        return waitAndDispatch(deadline);
+    }
+
+    /**
+     * Limits the queue of events received from other threads, shared by all notifiers of the thread.
+     * Notifier's own queue is limited by the constructor argument, Block policy is not available there.
+     */
+    void setThreadQueueLimit(QueueLimit limit);
+    std::size_t droppedEvents() const;
+    std::size_t droppedThreadEvents() const;
+    std::size_t queuedThreadEvents() const;    // received from other threads, not dispatched yet
 
 private:
+    template <typename T>
+    std::function<void()> addSubscription(ISubscription* subscriber, std::optional<IEvent::Key_t> topic,
+                                          std::function<bool(const T&)> filter)
+    {
+        static_assert(EventType<T>, "Subscribed type must derive from easy::Event<T>, subscribe to its base event");
+
+        const auto eventIndex = T::INDEX();
+        auto eventFilter = EventFilters::Filter{};
+        if (filter)
+        {
+            eventFilter = std::make_shared<const EventFilter>([filter = std::move(filter)](const IEvent& event) {
+                return filter(static_cast<const T&>(event));
+            });
+        }
+
+        m_proxy.subscribe(m_uuid, eventIndex, topic, eventFilter);
+        auto handle = subscriptionsOf(eventIndex, topic).insert({subscriber, std::move(eventFilter)});
+        return [handle, eventIndex, topic, this]() {
+            unsubscribe(eventIndex, topic, handle);
+        };
+    }
+
+    template <typename T, typename Awaiters>
+    Awaiters& awaitersOf(std::optional<IEvent::Key_t> topic)
+    {
+        const auto eventIndex = T::INDEX();
+        if (eventIndex >= m_awaiters.size())
+        {
+            m_awaiters.resize(eventIndex + 1);
+        }
+        if (!m_awaiters[eventIndex])
+        {
+            auto awaiters = std::make_unique<Awaiters>();
+            awaiters->setUnsubscriber(addSubscription<T>(awaiters.get(), topic, {}));
+            m_awaiters[eventIndex] = std::move(awaiters);
+        }
+        return static_cast<Awaiters&>(*m_awaiters[eventIndex]);
+    }
+
+    template <typename R, typename T>
+    ReplyAwaiter<R> sendRequest(T event, std::optional<std::chrono::steady_clock::time_point> deadline)
+    {
+        auto& replies = awaitersOf<Reply<R>, PendingReplies<R>>(m_uuid);
+        const auto timeout = deadline ? std::optional{timerTick(*deadline)} : std::nullopt;
+        const auto correlationId = ++m_lastCorrelationId;
+        const auto status = m_proxy.push(m_uuid, EventStorage(std::in_place_type<Request<T>>, std::move(event),
+                                                              m_uuid, correlationId));
+        if (status != PublishStatus::Ok)
+            return ReplyAwaiter<R>();    // the reply would never come
+        return ReplyAwaiter<R>(replies, correlationId, m_timers, timeout);
+    }
+
+    TimerHandle schedule(std::chrono::steady_clock::time_point time, DelayedEvent event,
+                         std::chrono::milliseconds period = {});
+    TimerWheel<DelayedEvent>::Tick timerTick(std::chrono::steady_clock::time_point time) const;
+    void publishExpiredEvents();
+    std::optional<std::chrono::steady_clock::time_point> nextTimerExpiry() const;
+
+    SubscriptionsList& subscriptionsOf(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic);
+    SubscriptionsList* findSubscriptions(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic);
+    void unsubscribe(IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic, SubscriptionsList::Handle handle);
+    void removePendingSubscriptions();
+
+    std::size_t dispatch(std::size_t maxEvents, std::optional<std::chrono::steady_clock::time_point> deadline);
+    std::size_t waitAndDispatch(std::optional<std::chrono::steady_clock::time_point> deadline);
+
+    template <typename T>
+    static EventStorage makeEvent(T&& event)
+    {
+        if constexpr (std::is_base_of_v<IEvent, std::remove_cvref_t<T>>)
+        {
+            return EventStorage(std::forward<T>(event));
+        }
+        else
+        {
+            return std::visit([](auto&& alternative) {
+                return makeEvent(std::forward<decltype(alternative)>(alternative));
+            }, std::forward<T>(event));
+        }
+    }
+
     static UUID_t getNextUuid();
 
 private:
-    std::map<IEvent::UUID_t, SubscriptionsList> m_subscriptions;
+    std::vector<SubscriptionsList> m_subscriptions;    // indexed by event index
+    std::unordered_map<EventTopic, SubscriptionsList, EventTopicHash> m_topicSubscriptions;
+    std::vector<std::unique_ptr<ISubscription>> m_awaiters;    // indexed by event index, also pending replies
+    std::vector<std::tuple<IEvent::Index_t, std::optional<IEvent::Key_t>,
+                           SubscriptionsList::Handle>> m_pendingUnsubscriptions;
+    TimerWheel<DelayedEvent> m_timers;    // ticks are milliseconds since m_timersEpoch
+    std::chrono::steady_clock::time_point m_timersEpoch = std::chrono::steady_clock::now();
+    IEvent::Key_t m_lastCorrelationId = 0;
     UUID_t m_uuid;
     NotifierProxy& m_proxy;
+    Strand* m_strand = nullptr;
     bool m_dispatchRecursionBarrier = false;
 };
 
@@ -1,8 +1,12 @@
 #include "notifierpool.hpp"
 
-#include <thread>
+#include <algorithm>
+#include <array>
 #include <mutex>
 #include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 #include "notifier.hpp"
 #include "notifierproxy.hpp"
@@ -12,70 +16,462 @@
 namespace easy
 {
 
-inline static std::map<std::thread::id, NotifierThreadContext> setupNotifiers = {};
-inline static std::shared_mutex poolAccessMutex = {};
+namespace
+{
+
+constexpr auto CONTEXTS_PER_CHUNK = std::size_t{64};
+constexpr auto MAX_CONTEXTS_CHUNKS = std::size_t{256};
+
+struct ContextsChunk
+{
+    std::array<NotifierThreadContext, CONTEXTS_PER_CHUNK> contexts;
+};
+
+/**
+ * Thread contexts live in chunks which are never released or moved, so other threads
+ * may keep pointers to them. Slots of finished threads are reused.
+ */
+struct ContextsRegistry
+{
+    std::array<std::unique_ptr<ContextsChunk>, MAX_CONTEXTS_CHUNKS> chunks = {};
+    std::size_t usedSlots = {};
+    std::mutex registrationMutex = {};
+    std::vector<NotifierThreadContext*> freeSlots = {};
+};
+
+/**
+ * Inverted index from event to contexts subscribed for it, publishers only visit
+ * inboxes of threads which are interested in the event. The index is a table
+ * addressed directly by the dense event index, keyed subscriptions are hashed by topic.
+ */
+struct SubscribersIndex
+{
+    inline void insert(IEvent::Index_t eventIndex, NotifierThreadContext* context)
+    {
+        if (eventIndex >= contexts.size())
+        {
+            contexts.resize(eventIndex + 1);
+        }
+        contexts[eventIndex].push_back(context);
+    }
+
+    inline void insert(const EventTopic& topic, NotifierThreadContext* context)
+    {
+        topics[topic].push_back(context);
+    }
+
+    inline void erase(IEvent::Index_t eventIndex, NotifierThreadContext* context)
+    {
+        if (eventIndex < contexts.size())
+        {
+            std::erase(contexts[eventIndex], context);
+        }
+    }
+
+    inline void erase(const EventTopic& topic, NotifierThreadContext* context)
+    {
+        auto topicContexts = topics.find(topic);
+        if (topicContexts == topics.end())
+            return;
+
+        std::erase(topicContexts->second, context);
+        if (topicContexts->second.empty())
+        {
+            topics.erase(topicContexts);
+        }
+    }
+
+    inline const std::vector<NotifierThreadContext*>* find(IEvent::Index_t eventIndex) const
+    {
+        return eventIndex < contexts.size() && !contexts[eventIndex].empty() ? &contexts[eventIndex] : nullptr;
+    }
+
+    inline const std::vector<NotifierThreadContext*>* find(const EventTopic& topic) const
+    {
+        auto topicContexts = topics.find(topic);
+        return topicContexts != topics.end() ? &topicContexts->second : nullptr;
+    }
+
+    std::shared_mutex accessMutex = {};
+    std::vector<std::vector<NotifierThreadContext*>> contexts = {};
+    std::unordered_map<EventTopic, std::vector<NotifierThreadContext*>, EventTopicHash> topics = {};
+};
+
+ContextsRegistry registry = {};
+SubscribersIndex subscribersIndex = {};
+thread_local NotifierThreadContext* threadContext = nullptr;
+
+
+NotifierThreadContext& acquireContext()
+{
+    std::unique_lock lockRegistration(registry.registrationMutex);
+    if (!registry.freeSlots.empty())
+    {
+        auto context = registry.freeSlots.back();
+        registry.freeSlots.pop_back();
+        return *context;
+    }
+
+    const auto slot = registry.usedSlots;
+    const auto chunkIndex = slot / CONTEXTS_PER_CHUNK;
+    if (chunkIndex >= MAX_CONTEXTS_CHUNKS)
+    {
+        throw std::length_error("easy::NotifiersPool: too many threads with notifiers");
+    }
+
+    auto& chunk = registry.chunks[chunkIndex];
+    if (!chunk)
+    {
+        chunk = std::make_unique<ContextsChunk>();
+    }
+    ++registry.usedSlots;
+    return chunk->contexts[slot % CONTEXTS_PER_CHUNK];
+}
+
+void releaseContext(NotifierThreadContext& context)
+{
+    std::unique_lock lockRegistration(registry.registrationMutex);
+    registry.freeSlots.push_back(&context);
+}
+
+template <typename Filters>
+void removeFilters(NotifierThreadContext& context, IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                   const Filters& filters)
+{
+    std::unique_lock lockWrite(subscribersIndex.accessMutex);
+    if (!topic)
+    {
+        if (!context.isSubscribed(eventIndex))
+            return;
+
+        auto& subscribedFilters = context.subscribedEvents[eventIndex];
+        subscribedFilters.remove(filters);
+        if (subscribedFilters.empty())
+        {
+            subscribersIndex.erase(eventIndex, &context);
+        }
+        return;
+    }
+
+    const auto eventTopic = EventTopic{eventIndex, *topic};
+    auto topicFilters = context.subscribedTopics.find(eventTopic);
+    if (topicFilters == context.subscribedTopics.end())
+        return;
+
+    topicFilters->second.remove(filters);
+    if (topicFilters->second.empty())
+    {
+        context.subscribedTopics.erase(topicFilters);
+        subscribersIndex.erase(eventTopic, &context);
+    }
+}
+
+/**
+ * Calls the function for every context except the source, which has a subscriber accepting the event.
+ * Called under lock of subscribers index.
+ */
+template <typename Function>
+void forEachReceiver(const NotifierThreadContext& source, const IEvent& event, Function&& function)
+{
+    const auto eventIndex = event.index();
+    if (auto contexts = subscribersIndex.find(eventIndex))
+    {
+        for (auto context : *contexts)
+        {
+            if (context != &source && context->accepts(event))
+                function(*context);
+        }
+    }
+
+    if (subscribersIndex.topics.empty())
+        return;
+
+    if (auto contexts = subscribersIndex.find(EventTopic{eventIndex, event.topic()}))
+    {
+        for (auto context : *contexts)
+        {
+            if (context != &source && !context->isSubscribed(eventIndex)    // others were visited above
+                && context->accepts(event))
+            {
+                function(*context);
+            }
+        }
+    }
+}
+
+}  // namespace
 
 
 NotifierProxy& NotifiersPool::setup()
 {
-    const auto id = std::this_thread::get_id();
-    std::unique_lock lockWrite(poolAccessMutex);
-    if (!setupNotifiers.contains(id))
+    if (!threadContext)
     {
-        setupNotifiers.try_emplace(id, NotifierThreadContext());
+        threadContext = &acquireContext();
     }
-    auto& context = setupNotifiers.at(id);
+    return setup(*threadContext);
+}
+
+NotifierProxy& NotifiersPool::setup(NotifierThreadContext& context)
+{
     ++context.referenceCounter;
     return context.proxy;
 }
 
-void NotifiersPool::teardown()
+NotifierThreadContext& NotifiersPool::createContext(IScheduler& scheduler)
+{
+    auto& context = acquireContext();
+    context.scheduler = &scheduler;
+    ++context.referenceCounter;
+    return context;
+}
+
+void NotifiersPool::teardown(NotifierThreadContext& context)
 {
-    const auto id = std::this_thread::get_id();
-    std::unique_lock lockWrite(poolAccessMutex);
-    auto& context = setupNotifiers.at(id);
     if (--context.referenceCounter == 0)
     {
-        setupNotifiers.erase(id);
+        {
+            std::unique_lock lockWrite(subscribersIndex.accessMutex);
+            for (auto eventIndex = IEvent::Index_t{}; eventIndex < context.subscribedEvents.size(); ++eventIndex)
+            {
+                if (!context.subscribedEvents[eventIndex].empty())
+                    subscribersIndex.erase(eventIndex, &context);
+            }
+            context.subscribedEvents.clear();
+            for (const auto& [topic, filters] : context.subscribedTopics)
+            {
+                subscribersIndex.erase(topic, &context);
+            }
+            context.subscribedTopics.clear();
+        }
+        context.reset();
+        if (threadContext == &context)
+        {
+            threadContext = nullptr;
+        }
+        releaseContext(context);
     }
 }
 
-void NotifiersPool::push(std::shared_ptr<IEvent> event)
+PublishStatus NotifiersPool::push(NotifierThreadContext& source, EventStorage event)
 {
-    std::unique_lock lockWrite(poolAccessMutex);
-    for (auto& [id, notifier] : setupNotifiers)
+    auto status = PublishStatus::Ok;
+    auto blockedContexts = std::vector<NotifierThreadContext*>{};
+    const auto priority = event->priority();
+    auto deliver = [&blockedContexts, priority](NotifierThreadContext& context, EventStorage&& event) {
+        context.events.push(std::move(event));
+        context.wakeUp();
+        if (context.isBlocking() && NotifierThreadContext::isLimited(priority))
+            blockedContexts.push_back(&context);
+    };
+
+    std::shared_lock lockRead(subscribersIndex.accessMutex);
+    auto lastAccepted = static_cast<NotifierThreadContext*>(nullptr);    // receives the publisher's storage
+    const auto isConflating = event->isConflating();
+    forEachReceiver(source, *event, [&](NotifierThreadContext& context) {
+        if (isConflating && context.conflate(event))
+            return;    // replaced pending event of the same key
+
+        switch (context.admit(priority))
+        {
+        case NotifierThreadContext::Admission::Accepted:
+            if (lastAccepted)
+                deliver(*lastAccepted, EventStorage(event));
+            lastAccepted = &context;
+            break;
+        case NotifierThreadContext::Admission::Rejected:
+            status = PublishStatus::QueueFull;
+            break;
+        case NotifierThreadContext::Admission::Dropped:
+            break;
+        }
+    });
+    if (lastAccepted)
     {
-        if (id == std::this_thread::get_id())
-            continue;
+        deliver(*lastAccepted, std::move(event));
+    }
+    lockRead.unlock();    // consumers need exclusive access to subscribe while the publisher waits
 
-        if (notifier.subscribedEvents.contains(event->uuid()))
+    for (auto context : blockedContexts)
+    {
+        context->waitForSpace();
+    }
+    return status;
+}
+
+PublishStatus NotifiersPool::push(NotifierThreadContext& source, std::vector<EventStorage>&& events)
+{
+    using EventsBatch = MpscQueue<EventStorage>::Batch;
+    auto status = PublishStatus::Ok;
+    auto batches = std::vector<std::pair<NotifierThreadContext*, EventsBatch>>{};
+    auto batchFor = [&batches](NotifierThreadContext* context) -> EventsBatch& {
+        auto batchIt = std::find_if(batches.begin(), batches.end(), [context](const auto& batch) {
+            return batch.first == context;
+        });
+        if (batchIt == batches.end())
+        {
+            batchIt = batches.emplace(batches.end(), context, EventsBatch{});
+        }
+        return batchIt->second;
+    };
+
+    auto flushBatches = [&batches]() {
+        for (auto& [context, batch] : batches)
+        {
+            if (batch.empty())
+                continue;
+
+            context->events.push(std::move(batch));
+            context->wakeUp();
+        }
+    };
+
+    // limited inbox gets the batch in chunks up to its capacity, so the oldest events can be evicted
+    // from it and a blocking publisher waits before the rest of the batch
+    auto isChunkFull = false;
+    auto blockedContexts = std::vector<NotifierThreadContext*>{};
+    auto limitedContexts = std::vector<NotifierThreadContext*>{};    // received events which may block
+    std::shared_lock lockRead(subscribersIndex.accessMutex);
+    for (auto& event : events)
+    {
+        const auto priority = event->priority();
+        const auto isConflating = event->isConflating();
+        if (isConflating)
         {
-            notifier.events.push_back(event);
+            flushBatches();    // pending event of the same key may be in the batch
         }
+
+        auto lastAccepted = static_cast<NotifierThreadContext*>(nullptr);    // receives the publisher's storage
+        forEachReceiver(source, *event, [&](NotifierThreadContext& context) {
+            if (isConflating && context.conflate(event))
+                return;
+
+            const auto admission = context.admit(priority);
+            if (admission == NotifierThreadContext::Admission::Rejected)
+                status = PublishStatus::QueueFull;
+            if (admission != NotifierThreadContext::Admission::Accepted)
+                return;
+
+            if (lastAccepted)
+                batchFor(lastAccepted).push(EventStorage(event));
+            lastAccepted = &context;
+
+            const auto isBlocking = context.isBlocking() && NotifierThreadContext::isLimited(priority);
+            if (isBlocking && std::ranges::find(limitedContexts, &context) == limitedContexts.end())
+                limitedContexts.push_back(&context);
+            if (context.isFull())
+            {
+                isChunkFull = true;
+                if (isBlocking)
+                    blockedContexts.push_back(&context);
+            }
+        });
+
+        if (lastAccepted)
+        {
+            batchFor(lastAccepted).push(std::move(event));
+        }
+
+        if (std::exchange(isChunkFull, false))
+        {
+            flushBatches();
+            if (!blockedContexts.empty())
+            {
+                lockRead.unlock();    // consumers need exclusive access to subscribe while the publisher waits
+                for (auto context : blockedContexts)
+                {
+                    context->waitForSpace();
+                }
+                blockedContexts.clear();
+                lockRead.lock();
+            }
+        }
+    }
+
+    flushBatches();
+    lockRead.unlock();
+
+    for (auto context : limitedContexts)
+    {
+        context->waitForSpace();
     }
+    return status;
+}
+
+bool NotifiersPool::wait(NotifierThreadContext& context, std::optional<std::chrono::steady_clock::time_point> deadline)
+{
+    auto hasEvents = [&context]() { return context.hasEvents(); };
+
+    context.isWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);    // pairs with fence in NotifierThreadContext::wakeUp
+
+    auto isWokenUp = true;
+    {
+        std::unique_lock lock(context.wakeUpMutex);
+        if (deadline)
+            isWokenUp = context.wakeUpCondition.wait_until(lock, *deadline, hasEvents);
+        else
+            context.wakeUpCondition.wait(lock, hasEvents);
+    }
+
+    context.isWaiting.store(false, std::memory_order_relaxed);
+    return isWokenUp;
+}
+
+void NotifiersPool::setLimit(NotifierThreadContext& context, QueueLimit limit)
+{
+    context.capacity.store(limit.capacity, std::memory_order_relaxed);
+    context.overflowPolicy.store(limit.policy, std::memory_order_relaxed);
+}
+
+std::size_t NotifiersPool::droppedEvents(NotifierThreadContext& context)
+{
+    return context.droppedEvents.load(std::memory_order_relaxed);
 }
 
-std::deque<std::shared_ptr<IEvent>> NotifiersPool::pull()
+std::size_t NotifiersPool::queuedEvents(NotifierThreadContext& context)
 {
-    auto events = std::deque<std::shared_ptr<IEvent>>{};
-    std::shared_lock lockRead(poolAccessMutex);
-    auto& context = setupNotifiers.at(std::this_thread::get_id());
-    std::swap(events, context.events);
-    return events;
+    return context.queuedEvents.load(std::memory_order_relaxed);
+}
+
+void NotifiersPool::subscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                              std::optional<IEvent::Key_t> topic, const EventFilters::Filter& filter)
+{
+    std::unique_lock lockWrite(subscribersIndex.accessMutex);
+    if (topic)
+    {
+        const auto eventTopic = EventTopic{eventIndex, *topic};
+        auto& topicFilters = context.subscribedTopics[eventTopic];
+        if (topicFilters.empty())
+        {
+            subscribersIndex.insert(eventTopic, &context);
+        }
+        topicFilters.add(filter);
+        return;
+    }
+
+    if (eventIndex >= context.subscribedEvents.size())
+    {
+        context.subscribedEvents.resize(eventIndex + 1);
+    }
+
+    auto& subscribedFilters = context.subscribedEvents[eventIndex];
+    if (subscribedFilters.empty())
+    {
+        subscribersIndex.insert(eventIndex, &context);
+    }
+    subscribedFilters.add(filter);
 }
 
-void NotifiersPool::subscribe(IEvent::UUID_t eventId)
+void NotifiersPool::unsubscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                                std::optional<IEvent::Key_t> topic, const EventFilters::Filter& filter)
 {
-    std::shared_lock lockRead(poolAccessMutex);
-    auto& context = setupNotifiers.at(std::this_thread::get_id());
-    context.subscribedEvents.insert(eventId);
+    removeFilters(context, eventIndex, topic, filter);
 }
 
-void NotifiersPool::unsubscribe(IEvent::UUID_t eventId)
+void NotifiersPool::unsubscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                                std::optional<IEvent::Key_t> topic, const EventFilters& filters)
 {
-    std::shared_lock lockRead(poolAccessMutex);
-    auto& context = setupNotifiers.at(std::this_thread::get_id());
-    context.subscribedEvents.erase(eventId);
+    removeFilters(context, eventIndex, topic, filters);
 }
 
 }  // namespace
@@ -3,10 +3,16 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
-#include <deque>
+#include <optional>
+#include <vector>
 
 #include "event.hpp"
+#include "eventfilters.hpp"
+#include "eventstorage.hpp"
+#include "notifierthreadcontext.hpp"
+#include "queuelimit.hpp"
 
 
 namespace easy
@@ -14,24 +20,44 @@ namespace easy
 
 class Notifier;
 class NotifierProxy;
-class NotifierThreadContext;
+class Strand;
 
 class NotifiersPool
 {
     friend class Notifier;
     friend class NotifierProxy;
+    friend class Strand;
 
 private:
     static NotifierProxy& setup();
-    static void teardown();
-
-    static void push(std::shared_ptr<IEvent> event);
-    static std::deque<std::shared_ptr<IEvent>> pull();
-
-    static void subscribe(IEvent::UUID_t eventId);
-    static void unsubscribe(IEvent::UUID_t eventId);
-
-    static NotifierThreadContext& getContext();
+    static NotifierProxy& setup(NotifierThreadContext& context);
+    static NotifierThreadContext& createContext(IScheduler& scheduler);
+    static void teardown(NotifierThreadContext& context);
+
+    static PublishStatus push(NotifierThreadContext& source, EventStorage event);
+    static PublishStatus push(NotifierThreadContext& source, std::vector<EventStorage>&& events);
+
+    template <typename Function>
+    static std::size_t pull(NotifierThreadContext& context, Function&& function)
+    {
+        return context.consumeEvents(std::forward<Function>(function));
+    }
+
+    static bool wait(NotifierThreadContext& context, std::optional<std::chrono::steady_clock::time_point> deadline);
+
+    static void setLimit(NotifierThreadContext& context, QueueLimit limit);
+    static std::size_t droppedEvents(NotifierThreadContext& context);
+    static std::size_t queuedEvents(NotifierThreadContext& context);
+
+    /**
+     * Subscribes the context for all events of the type, or only for the topic when it is given.
+     */
+    static void subscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                          std::optional<IEvent::Key_t> topic, const EventFilters::Filter& filter);
+    static void unsubscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                            std::optional<IEvent::Key_t> topic, const EventFilters::Filter& filter);
+    static void unsubscribe(NotifierThreadContext& context, IEvent::Index_t eventIndex,
+                            std::optional<IEvent::Key_t> topic, const EventFilters& filters);
 };
 
 }  // namespace easy
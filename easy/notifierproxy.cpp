@@ -1,74 +1,236 @@
 #include "notifierproxy.hpp"
 
+#include <algorithm>
+
 #include "notifierpool.hpp"
 
 
 namespace easy
 {
 
-void NotifierProxy::push(UUID_t notifierUuid, std::shared_ptr<IEvent> event)
+PublishStatus NotifierProxy::push(UUID_t notifierUuid, EventStorage event)
 {
-    NotifiersPool::push(event);
+    auto status = pushLocal(notifierUuid, event);
+    if (NotifiersPool::push(*m_context, std::move(event)) != PublishStatus::Ok)    // publisher gives up its storage
+    {
+        status = PublishStatus::QueueFull;
+    }
+    return status;
+}
 
-    auto notifiersSubscribedForEventUuidsIt = m_subscribedEvents.find(event->uuid());
-    if (notifiersSubscribedForEventUuidsIt == m_subscribedEvents.end())
-        return;
+PublishStatus NotifierProxy::push(UUID_t notifierUuid, std::vector<EventStorage>&& events)
+{
+    auto status = PublishStatus::Ok;
+    for (const auto& event : events)
+    {
+        if (pushLocal(notifierUuid, event) != PublishStatus::Ok)
+        {
+            status = PublishStatus::QueueFull;
+        }
+    }
+    if (NotifiersPool::push(*m_context, std::move(events)) != PublishStatus::Ok)
+    {
+        status = PublishStatus::QueueFull;
+    }
+    return status;
+}
+
+PublishStatus NotifierProxy::pushLocal(UUID_t notifierUuid, const EventStorage& event)
+{
+    auto status = PublishStatus::Ok;
+    forEachReceiver(*event, false, [&](const EventSubscriber& subscriber) {
+        if (subscriber.notifierUuid != notifierUuid && enqueue(*subscriber.queue, event) != PublishStatus::Ok)
+        {
+            status = PublishStatus::QueueFull;
+        }
+    });
+    return status;
+}
+
+NotifierProxy::EventsQueue& NotifierProxy::pull(UUID_t notifierUuid)
+{
+    NotifiersPool::pull(*m_context, [this](EventStorage&& event) {
+        forEachReceiver(*event, true, [&event](const EventSubscriber& subscriber) {    // none when unsubscribed
+            enqueue(*subscriber.queue, event);
+        });
+    });
+    return m_subscribedNotifiersEventQueue[notifierUuid].events;
+}
+
+void NotifierProxy::release(UUID_t notifierUuid)
+{
+    for (auto eventIndex = IEvent::Index_t{}; eventIndex < m_subscribedEvents.size(); ++eventIndex)
+    {
+        auto& subscribers = m_subscribedEvents[eventIndex];
+        auto subscriber = findSubscriber(subscribers, notifierUuid);
+        if (subscriber != subscribers.end())
+        {
+            NotifiersPool::unsubscribe(*m_context, eventIndex, std::nullopt, subscriber->filters);
+            subscribers.erase(subscriber);
+        }
+    }
 
-    for (const auto& subscribedNotifierUuid : notifiersSubscribedForEventUuidsIt->second)
+    for (auto topicIt = m_subscribedTopics.begin(); topicIt != m_subscribedTopics.end();)
     {
-        if (subscribedNotifierUuid != notifierUuid)
+        auto& [topic, subscribers] = *topicIt;
+        auto subscriber = findSubscriber(subscribers, notifierUuid);
+        if (subscriber != subscribers.end())
         {
-            m_subscribedNotifiersEventQueue[subscribedNotifierUuid].push(event);
+            NotifiersPool::unsubscribe(*m_context, topic.eventIndex, topic.key, subscriber->filters);
+            subscribers.erase(subscriber);
         }
+        topicIt = subscribers.empty() ? m_subscribedTopics.erase(topicIt) : std::next(topicIt);
+    }
+    m_subscribedNotifiersEventQueue.erase(notifierUuid);
+}
+
+void NotifierProxy::setLimit(UUID_t notifierUuid, QueueLimit limit)
+{
+    m_subscribedNotifiersEventQueue[notifierUuid].limit = limit;
+}
+
+std::size_t NotifierProxy::droppedEvents(UUID_t notifierUuid) const
+{
+    auto queueIt = m_subscribedNotifiersEventQueue.find(notifierUuid);
+    return queueIt != m_subscribedNotifiersEventQueue.end() ? queueIt->second.droppedEvents : 0;
+}
+
+void NotifierProxy::subscribe(UUID_t notifierUuid, IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                              const EventFilters::Filter& filter)
+{
+    if (!topic && eventIndex >= m_subscribedEvents.size())
+    {
+        m_subscribedEvents.resize(eventIndex + 1);
     }
+
+    auto& subscribers = topic ? m_subscribedTopics[EventTopic{eventIndex, *topic}] : m_subscribedEvents[eventIndex];
+    auto subscriber = findSubscriber(subscribers, notifierUuid);
+    if (subscriber == subscribers.end())
+    {
+        subscriber = subscribers.insert(subscribers.end(),
+                                        {notifierUuid, &m_subscribedNotifiersEventQueue[notifierUuid], {}});
+    }
+    subscriber->filters.add(filter);
+    NotifiersPool::subscribe(*m_context, eventIndex, topic, filter);
 }
 
-std::shared_ptr<IEvent> NotifierProxy::pull(UUID_t notifierUuid)
+void NotifierProxy::unsubscribe(UUID_t notifierUuid, IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                                const EventFilters::Filter& filter)
 {
-    if (m_subscribedNotifiersEventQueue[notifierUuid].empty())
+    auto subscribers = topic ? findSubscribers(EventTopic{eventIndex, *topic}) : findSubscribers(eventIndex);
+    if (!subscribers)
+        return;
+
+    auto subscriber = findSubscriber(*subscribers, notifierUuid);
+    if (subscriber == subscribers->end())
+        return;
+
+    subscriber->filters.remove(filter);
+    if (subscriber->filters.empty())
     {
-        auto events = NotifiersPool::pull();
-        for (const auto& event : events)
+        subscribers->erase(subscriber);
+        if (topic && subscribers->empty())
         {
-            if (!m_subscribedEvents.contains(event->uuid()))    // when unsubscribed but events were in buffer
-                continue;
+            m_subscribedTopics.erase(EventTopic{eventIndex, *topic});
+        }
+    }
+    NotifiersPool::unsubscribe(*m_context, eventIndex, topic, filter);
+}
 
-            for (const auto& notifiersForEvent : m_subscribedEvents.at(event->uuid()))
+bool NotifierProxy::hasQueuedEvents() const
+{
+    return std::any_of(m_subscribedNotifiersEventQueue.begin(), m_subscribedNotifiersEventQueue.end(),
+                       [](const auto& queue) { return !queue.second.events.empty(); });
+}
+
+/**
+ * Calls the function for every notifier with subscriber accepting the event, notifiers subscribed
+ * both for the event type and its topic are visited once.
+ */
+template <typename Function>
+void NotifierProxy::forEachReceiver(const IEvent& event, bool isFilteredByPublisher, Function&& function)
+{
+    const auto eventIndex = event.index();
+    auto subscribers = findSubscribers(eventIndex);
+    auto topicSubscribers = m_subscribedTopics.empty() ? nullptr
+                                                       : findSubscribers(EventTopic{eventIndex, event.topic()});
+    const auto receivers = (subscribers ? subscribers->size() : 0) + (topicSubscribers ? topicSubscribers->size() : 0);
+    const auto isAccepted = isFilteredByPublisher && receivers == 1;    // publisher applied the same filters
+
+    auto acceptsTopic = [&](UUID_t notifierUuid) {
+        auto subscriber = findSubscriber(*topicSubscribers, notifierUuid);
+        return subscriber != topicSubscribers->end() && subscriber->filters.accepts(event);
+    };
+
+    if (subscribers)
+    {
+        for (const auto& subscriber : *subscribers)
+        {
+            if (isAccepted || subscriber.filters.accepts(event)
+                || (topicSubscribers && acceptsTopic(subscriber.notifierUuid)))
             {
-                m_subscribedNotifiersEventQueue.at(notifiersForEvent).push(event);
+                function(subscriber);
             }
         }
     }
 
-    if (!m_subscribedNotifiersEventQueue[notifierUuid].empty())
+    if (topicSubscribers)
     {
-        auto front = m_subscribedNotifiersEventQueue[notifierUuid].front();
-        m_subscribedNotifiersEventQueue[notifierUuid].pop();
-        return front;
+        for (const auto& subscriber : *topicSubscribers)
+        {
+            if (subscribers && findSubscriber(*subscribers, subscriber.notifierUuid) != subscribers->end())
+                continue;    // visited above
+
+            if (isAccepted || subscriber.filters.accepts(event))
+            {
+                function(subscriber);
+            }
+        }
     }
-    return {};
 }
 
-void NotifierProxy::subscribe(UUID_t notifierUuid, IEvent::UUID_t eventId)
+std::vector<NotifierProxy::EventSubscriber>* NotifierProxy::findSubscribers(IEvent::Index_t eventIndex)
 {
-    if (!m_subscribedEvents.contains(eventId))
-    {
-        NotifiersPool::subscribe(eventId);
-    }
-    m_subscribedEvents[eventId].insert(notifierUuid);
+    return eventIndex < m_subscribedEvents.size() && !m_subscribedEvents[eventIndex].empty()
+         ? &m_subscribedEvents[eventIndex]
+         : nullptr;
 }
 
-void NotifierProxy::unsubscribe(UUID_t notifierUuid, IEvent::UUID_t eventId)
+std::vector<NotifierProxy::EventSubscriber>* NotifierProxy::findSubscribers(const EventTopic& topic)
 {
-    m_subscribedNotifiersEventQueue.erase(notifierUuid);
-    m_subscribedEvents[eventId].erase(notifierUuid);
+    auto topicIt = m_subscribedTopics.find(topic);
+    return topicIt != m_subscribedTopics.end() ? &topicIt->second : nullptr;
+}
 
-    if (m_subscribedEvents[eventId].empty())
+std::vector<NotifierProxy::EventSubscriber>::iterator NotifierProxy::findSubscriber(
+    std::vector<EventSubscriber>& subscribers, UUID_t notifierUuid)
+{
+    return std::find_if(subscribers.begin(), subscribers.end(), [notifierUuid](const auto& subscriber) {
+        return subscriber.notifierUuid == notifierUuid;
+    });
+}
+
+PublishStatus NotifierProxy::enqueue(NotifierQueue& queue, const EventStorage& event)
+{
+    if (queue.events.conflate(event))    // replaced pending event of the same key
     {
-        m_subscribedEvents.erase(eventId);
+        return PublishStatus::Ok;
+    }
 
-        NotifiersPool::unsubscribe(eventId);
+    if (queue.events.size() >= queue.limit.capacity)
+    {
+        ++queue.droppedEvents;
+        if (queue.limit.policy != OverflowPolicy::DropOldest)
+        {
+            return queue.limit.policy == OverflowPolicy::Fail ? PublishStatus::QueueFull : PublishStatus::Ok;
+        }
+        if (!queue.events.dropOldest(event->priority()))    // queued events are all more important
+        {
+            return PublishStatus::Ok;
+        }
     }
+    queue.events.push(event);
+    return PublishStatus::Ok;
 }
 
 }  // namespace
@@ -3,37 +3,81 @@
  */
 #pragma once
 
-#include <memory>
-#include <queue>
-#include <set>
 #include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "event.hpp"
+#include "eventfilters.hpp"
+#include "eventlanes.hpp"
+#include "eventstorage.hpp"
+#include "queuelimit.hpp"
 
 
 namespace easy
 {
 
+class NotifierThreadContext;
+
 class NotifierProxy
 {
     friend class NotifierThreadContext;
 
 public:
     using UUID_t = uint64_t;
+    using EventsQueue = EventLanes;
 
 private:
-    NotifierProxy() = default;
+    explicit NotifierProxy(NotifierThreadContext& context) : m_context{&context} {}
 
 public:
-    void push(UUID_t notifierUuid, std::shared_ptr<IEvent> event);
-    std::shared_ptr<IEvent> pull(UUID_t notifierUuid);
+    PublishStatus push(UUID_t notifierUuid, EventStorage event);
+    PublishStatus push(UUID_t notifierUuid, std::vector<EventStorage>&& events);
+    EventsQueue& pull(UUID_t notifierUuid);
+    void release(UUID_t notifierUuid);
+
+    void setLimit(UUID_t notifierUuid, QueueLimit limit);
+    std::size_t droppedEvents(UUID_t notifierUuid) const;
+
+    void subscribe(UUID_t notifierUuid, IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                   const EventFilters::Filter& filter);
+    void unsubscribe(UUID_t notifierUuid, IEvent::Index_t eventIndex, std::optional<IEvent::Key_t> topic,
+                     const EventFilters::Filter& filter);
+
+    bool hasQueuedEvents() const;
+    NotifierThreadContext& context() const { return *m_context; }
+
+private:
+    struct NotifierQueue
+    {
+        EventsQueue events;
+        QueueLimit limit;
+        std::size_t droppedEvents = 0;
+    };
+
+    struct EventSubscriber
+    {
+        UUID_t notifierUuid;
+        NotifierQueue* queue;
+        EventFilters filters;    // of notifier's subscribers
+    };
 
-    void subscribe(UUID_t notifierUuid, IEvent::UUID_t eventId);
-    void unsubscribe(UUID_t notifierUuid, IEvent::UUID_t eventId);
+    PublishStatus pushLocal(UUID_t notifierUuid, const EventStorage& event);
+    template <typename Function>
+    void forEachReceiver(const IEvent& event, bool isFilteredByPublisher, Function&& function);
+    std::vector<EventSubscriber>* findSubscribers(IEvent::Index_t eventIndex);
+    std::vector<EventSubscriber>* findSubscribers(const EventTopic& topic);
+    static std::vector<EventSubscriber>::iterator findSubscriber(std::vector<EventSubscriber>& subscribers,
+                                                                 UUID_t notifierUuid);
+    static PublishStatus enqueue(NotifierQueue& queue, const EventStorage& event);
 
 private:
-    std::map<IEvent::UUID_t, std::set<UUID_t>> m_subscribedEvents;
-    std::map<UUID_t, std::queue<std::shared_ptr<IEvent>>> m_subscribedNotifiersEventQueue;
+    NotifierThreadContext* m_context;
+    std::vector<std::vector<EventSubscriber>> m_subscribedEvents;    // indexed by event index
+    std::unordered_map<EventTopic, std::vector<EventSubscriber>, EventTopicHash> m_subscribedTopics;
+    std::map<UUID_t, NotifierQueue> m_subscribedNotifiersEventQueue;
 };
 
 }  // namespace easy
@@ -3,10 +3,20 @@
  */
 #pragma once
 
-#include <deque>
-#include <set>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
+#include "eventfilters.hpp"
+#include "eventlanes.hpp"
+#include "eventstorage.hpp"
+#include "ischeduler.hpp"
+#include "mpscqueue.hpp"
 #include "notifierproxy.hpp"
+#include "queuelimit.hpp"
 
 
 namespace easy
@@ -14,11 +24,203 @@ namespace easy
 
 class NotifierThreadContext
 {
+public:
+    enum class Admission
+    {
+        Accepted,
+        Dropped,
+        Rejected
+    };
+
+public:
+    inline void reset()
+    {
+        events.consume([](EventStorage&&) {});
+        spilledEvents = EventLanes{};
+        proxy = NotifierProxy{*this};
+        scheduler = nullptr;
+        capacity.store(std::numeric_limits<std::size_t>::max(), std::memory_order_relaxed);
+        overflowPolicy.store(OverflowPolicy::DropNewest, std::memory_order_relaxed);
+        droppedEvents.store(0, std::memory_order_relaxed);
+        queuedEvents.store(0, std::memory_order_release);
+        queuedEvents.notify_all();
+    }
+
+    inline void wakeUp()
+    {
+        if (scheduler)
+        {
+            scheduler->schedule();
+            return;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);    // pairs with fence in NotifiersPool::wait
+        if (isWaiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard lock(wakeUpMutex);
+            wakeUpCondition.notify_one();
+        }
+    }
+
+    /**
+     * Called by publisher before pushing an event to the inbox. With DropOldest the oldest queued
+     * event of the lowest priority is evicted here, so the inbox does not grow while the consumer is slow.
+     * Blocking is handled after the push, by waitForSpace(). High priority events are not dropped
+     * for lack of space, nor do they block, so control events never starve behind data events.
+     */
+    inline Admission admit(Priority priority)
+    {
+        const auto policy = overflowPolicy.load(std::memory_order_relaxed);
+        const auto queued = queuedEvents.fetch_add(1, std::memory_order_relaxed);
+        if (queued < capacity.load(std::memory_order_relaxed) || policy == OverflowPolicy::Block)
+        {
+            return Admission::Accepted;
+        }
+        if (policy == OverflowPolicy::DropOldest ? dropOldest(priority) : !isLimited(priority))
+        {
+            return Admission::Accepted;
+        }
+
+        queuedEvents.fetch_sub(1, std::memory_order_relaxed);
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return policy == OverflowPolicy::Fail ? Admission::Rejected : Admission::Dropped;
+    }
+
+    static constexpr bool isLimited(Priority priority)
+    {
+        return priority != Priority::High;
+    }
+
+    /**
+     * Replaces pending conflating event of the same key, so while the consumer is busy the inbox keeps
+     * only the latest value, which does not take more space. The inbox is moved aside to find it.
+     */
+    inline bool conflate(const EventStorage& event)
+    {
+        std::lock_guard lock(spillMutex);
+        spill();
+        return spilledEvents.conflate(event);
+    }
+
+    /**
+     * True while events are queued, also the ones spilled from the inbox.
+     */
+    inline bool hasEvents() const
+    {
+        return queuedEvents.load(std::memory_order_acquire) > 0;
+    }
+
+    inline bool isBlocking() const
+    {
+        return overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::Block;
+    }
+
+    inline bool isFull() const
+    {
+        return queuedEvents.load(std::memory_order_relaxed) >= capacity.load(std::memory_order_relaxed);
+    }
+
+    inline void waitForSpace()
+    {
+        auto queued = queuedEvents.load(std::memory_order_acquire);
+        while (isBlocking() && queued > capacity.load(std::memory_order_relaxed))
+        {
+            queuedEvents.wait(queued, std::memory_order_acquire);
+            queued = queuedEvents.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * True when any subscriber of the context accepts the event, called under lock of subscribers index.
+     */
+    inline bool accepts(const IEvent& event) const
+    {
+        const auto eventIndex = event.index();
+        if (isSubscribed(eventIndex) && subscribedEvents[eventIndex].accepts(event))
+            return true;
+        if (subscribedTopics.empty())
+            return false;
+
+        auto topicFilters = subscribedTopics.find(EventTopic{eventIndex, event.topic()});
+        return topicFilters != subscribedTopics.end() && topicFilters->second.accepts(event);
+    }
+
+    /**
+     * True when subscribed for all topics of the event type.
+     */
+    inline bool isSubscribed(IEvent::Index_t eventIndex) const
+    {
+        return eventIndex < subscribedEvents.size() && !subscribedEvents[eventIndex].empty();
+    }
+
+    /**
+     * Events spilled from the inbox by publishers are older than the ones left in it, so both
+     * are taken under the spill lock to keep publication order within each priority.
+     */
+    template <typename Function>
+    inline std::size_t consumeEvents(Function&& function)
+    {
+        auto taken = std::size_t{};
+        {
+            std::lock_guard lock(spillMutex);
+            for (; !spilledEvents.empty(); ++taken)
+            {
+                function(spilledEvents.take());
+            }
+            taken += events.consume(function);
+        }
+
+        if (taken > 0)
+        {
+            queuedEvents.fetch_sub(taken, std::memory_order_release);
+            queuedEvents.notify_all();
+        }
+        return taken;
+    }
+
+private:
+    /**
+     * Moves the inbox aside into priority lanes and evicts the oldest event of the lowest priority,
+     * unless all queued events are more important than the publisher's one. The publisher's event
+     * is counted already, so it replaces the evicted one. Returns false when it has to be dropped instead.
+     */
+    inline bool dropOldest(Priority notAbove)
+    {
+        std::lock_guard lock(spillMutex);
+        spill();
+        if (spilledEvents.empty())    // the consumer has just taken everything
+            return true;
+
+        if (!spilledEvents.dropOldest(notAbove))
+            return false;
+        queuedEvents.fetch_sub(1, std::memory_order_relaxed);
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    inline void spill()
+    {
+        events.consume([this](EventStorage&& event) { spilledEvents.push(std::move(event)); });
+    }
+
 public:
     unsigned referenceCounter{0};
-    NotifierProxy proxy{};
-    std::deque<std::shared_ptr<IEvent>> events;
-    std::set<IEvent::UUID_t> subscribedEvents;
+    NotifierProxy proxy{*this};
+    IScheduler* scheduler = nullptr;
+    MpscQueue<EventStorage> events;
+    std::mutex spillMutex;
+    EventLanes spilledEvents;    // guarded by spillMutex
+    std::vector<EventFilters> subscribedEvents;    // indexed by event index, guarded by subscribers index
+    std::unordered_map<EventTopic, EventFilters, EventTopicHash> subscribedTopics;    // guarded by subscribers index
+
+    std::atomic_bool isWaiting{false};
+    std::mutex wakeUpMutex;
+    std::condition_variable wakeUpCondition;
+
+    std::atomic<std::size_t> queuedEvents{0};
+    std::atomic<std::size_t> droppedEvents{0};
+    std::atomic<std::size_t> capacity{std::numeric_limits<std::size_t>::max()};
+    std::atomic<OverflowPolicy> overflowPolicy{OverflowPolicy::DropNewest};
 };
 
 }  // namespace easy
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+
+namespace easy
+{
+
+/**
+ * Free lists of fixed size blocks. Each thread allocates from and releases to its own cache,
+ * blocks are exchanged with the shared list in batches, so blocks released by consumer threads
+ * come back to publishers without calls to the global allocator.
+ */
+template <std::size_t Size, std::size_t Alignment>
+class MemoryPool
+{
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static constexpr auto BLOCK_ALIGNMENT = std::max(Alignment, alignof(FreeBlock));
+    static constexpr auto BLOCK_SIZE = (std::max(Size, sizeof(FreeBlock)) + BLOCK_ALIGNMENT - 1)
+                                     / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+    static constexpr auto BATCH_SIZE = std::size_t{64};
+
+    struct FreeList
+    {
+        inline void push(FreeBlock* block)
+        {
+            block->next = head;
+            head = block;
+            ++size;
+        }
+
+        inline FreeBlock* pop()
+        {
+            auto block = head;
+            head = head->next;
+            --size;
+            return block;
+        }
+
+        inline void moveTo(FreeList& list, std::size_t count)
+        {
+            for (; count > 0 && head; --count)
+            {
+                list.push(pop());
+            }
+        }
+
+        FreeBlock* head = nullptr;
+        std::size_t size = 0;
+    };
+
+    struct SharedFreeList
+    {
+        std::mutex accessMutex;
+        FreeList blocks;
+    };
+
+    struct ThreadCache
+    {
+        ~ThreadCache()
+        {
+            isThreadCacheReleased = true;
+            std::lock_guard lock(sharedList().accessMutex);
+            blocks.moveTo(sharedList().blocks, blocks.size);
+        }
+
+        FreeList blocks;
+    };
+
+public:
+    static void* allocate()
+    {
+        if (isThreadCacheReleased)
+        {
+            auto list = FreeList{};
+            refill(list, 1);
+            return list.pop();
+        }
+
+        auto& cache = threadCache();
+        if (!cache.blocks.head)
+        {
+            refill(cache.blocks, BATCH_SIZE);
+        }
+        return cache.blocks.pop();
+    }
+
+    static void deallocate(void* pointer)
+    {
+        auto block = static_cast<FreeBlock*>(pointer);
+        if (isThreadCacheReleased)
+        {
+            std::lock_guard lock(sharedList().accessMutex);
+            sharedList().blocks.push(block);
+            return;
+        }
+
+        auto& cache = threadCache();
+        cache.blocks.push(block);
+        if (cache.blocks.size >= 2 * BATCH_SIZE)
+        {
+            std::lock_guard lock(sharedList().accessMutex);
+            cache.blocks.moveTo(sharedList().blocks, BATCH_SIZE);
+        }
+    }
+
+private:
+    static void refill(FreeList& list, std::size_t count)
+    {
+        {
+            std::lock_guard lock(sharedList().accessMutex);
+            sharedList().blocks.moveTo(list, count);
+        }
+
+        if (!list.head)
+        {
+            auto slab = static_cast<std::byte*>(::operator new(BLOCK_SIZE * BATCH_SIZE,
+                                                               std::align_val_t{BLOCK_ALIGNMENT}));
+            for (auto i = std::size_t{}; i < BATCH_SIZE; ++i)
+            {
+                list.push(new (slab + i * BLOCK_SIZE) FreeBlock{});
+            }
+        }
+    }
+
+    static ThreadCache& threadCache()
+    {
+        thread_local auto cache = ThreadCache{};
+        return cache;
+    }
+
+    static SharedFreeList& sharedList()
+    {
+        static auto list = new SharedFreeList();    // never released, blocks may come back during static destruction
+        return *list;
+    }
+
+    static inline thread_local bool isThreadCacheReleased = false;
+};
+
+
+template <typename T>
+struct PoolAllocator
+{
+    using value_type = T;
+    using Pool = MemoryPool<sizeof(T), alignof(T)>;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    inline T* allocate(std::size_t n)
+    {
+        if (n == 1)
+            return static_cast<T*>(Pool::allocate());
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    inline void deallocate(T* pointer, std::size_t n)
+    {
+        if (n == 1)
+            Pool::deallocate(pointer);
+        else
+            std::allocator<T>{}.deallocate(pointer, n);
+    }
+
+    template <typename U>
+    inline bool operator==(const PoolAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
+
+}  // namespace easy
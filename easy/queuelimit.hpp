@@ -0,0 +1,33 @@
+/**
+ * Created by Karol Dudzic @ 2024
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+
+namespace easy
+{
+
+enum class OverflowPolicy
+{
+    Block,         // publisher waits until the consumer makes room (thread queue only)
+    DropNewest,    // published event is dropped
+    DropOldest,    // the oldest queued event is dropped to make room
+    Fail           // published event is dropped and publish returns PublishStatus::QueueFull
+};
+
+enum class PublishStatus
+{
+    Ok,
+    QueueFull
+};
+
+struct QueueLimit
+{
+    std::size_t capacity = std::numeric_limits<std::size_t>::max();
+    OverflowPolicy policy = OverflowPolicy::DropNewest;
+};
+
+}  // namespace easy
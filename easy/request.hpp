@@ -0,0 +1,214 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "delayedevent.hpp"
+#include "event.hpp"
+#include "isubscription.hpp"
+#include "poolallocator.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Event T published by Notifier::request. Responders subscribe to Request<T> and answer with
+ * Notifier::reply, so plain subscribers of T do not receive requests.
+ */
+template <typename T>
+class Request : public Event<Request<T>, T::PRIORITY()>
+{
+public:
+    Request(T event, IEvent::UUID_t requester, IEvent::Key_t correlationId)
+        : event{std::move(event)}
+        , requester{requester}
+        , correlationId{correlationId}
+    {}
+
+    IEvent::Key_t topic() const override { return event.topic(); }
+
+public:
+    T event;
+    IEvent::UUID_t requester;
+    IEvent::Key_t correlationId;
+};
+
+/**
+ * Answer to a request, its topic is the UUID of the requesting notifier, so it is sent only there.
+ */
+template <typename T>
+class Reply : public Event<Reply<T>, T::PRIORITY()>
+{
+public:
+    Reply(T event, IEvent::UUID_t requester, IEvent::Key_t correlationId)
+        : event{std::move(event)}
+        , requester{requester}
+        , correlationId{correlationId}
+    {}
+
+    IEvent::Key_t topic() const override { return requester; }
+
+public:
+    T event;
+    IEvent::UUID_t requester;
+    IEvent::Key_t correlationId;
+};
+
+
+template <typename T>
+class PendingReplies;
+
+/**
+ * Awaitable for the reply T to one request, returned by Notifier::request. Awaiting gives std::nullopt
+ * when the request was rejected, the timeout expired or the notifier was destroyed. The coroutine
+ * is resumed inside Notifier::dispatch().
+ */
+template <typename T>
+class ReplyAwaiter
+{
+    friend class PendingReplies<T>;
+    using Timers = TimerWheel<DelayedEvent>;
+
+public:
+    ReplyAwaiter() = default;    // completed without reply
+    ReplyAwaiter(PendingReplies<T>& replies, IEvent::Key_t correlationId, Timers& timers,
+                 std::optional<Timers::Tick> timeout)
+        : m_replies{&replies}
+        , m_correlationId{correlationId}
+    {
+        replies.m_waiting.emplace(correlationId, this);
+        if (timeout)
+        {
+            m_timers = &timers;
+            m_timeout = timers.insert(*timeout, DelayedEvent{{}, {}, [this]() { timeOut(); }});
+        }
+    }
+
+    ~ReplyAwaiter()
+    {
+        detach();
+    }
+
+    ReplyAwaiter(const ReplyAwaiter&) = delete;
+    ReplyAwaiter& operator=(const ReplyAwaiter&) = delete;
+    ReplyAwaiter(ReplyAwaiter&&) = delete;
+    ReplyAwaiter& operator=(ReplyAwaiter&&) = delete;
+
+    bool await_ready() const noexcept { return !m_replies; }
+    void await_suspend(std::coroutine_handle<> coroutine) noexcept { m_coroutine = coroutine; }
+    std::optional<T> await_resume() { return std::move(m_reply); }
+
+private:
+    inline void detach()
+    {
+        if (auto replies = std::exchange(m_replies, nullptr))
+        {
+            replies->m_waiting.erase(m_correlationId);
+        }
+        if (auto timers = std::exchange(m_timers, nullptr))
+        {
+            timers->cancel(m_timeout);
+        }
+    }
+
+    template <typename Event>
+    inline void receive(Event&& event)
+    {
+        detach();
+        m_reply.emplace(std::forward<Event>(event));
+        resume();
+    }
+
+    inline void timeOut()
+    {
+        m_timers = nullptr;    // the timer is already removed
+        detach();
+        resume();
+    }
+
+    inline void resume()
+    {
+        if (auto coroutine = std::exchange(m_coroutine, nullptr))
+        {
+            coroutine.resume();    // may destroy the awaiter
+        }
+    }
+
+private:
+    std::optional<T> m_reply;
+    std::coroutine_handle<> m_coroutine;
+    PendingReplies<T>* m_replies = nullptr;
+    Timers* m_timers = nullptr;
+    Timers::Handle m_timeout;
+    IEvent::Key_t m_correlationId = {};
+};
+
+
+/**
+ * Subscription of a notifier for replies T to its requests, passes each reply to the awaiter
+ * of its correlation id. Replies to requests which are no longer awaited are ignored.
+ */
+template <typename T>
+class PendingReplies : public ISubscription
+{
+    friend class ReplyAwaiter<T>;
+    using Awaiters = std::unordered_map<IEvent::Key_t, ReplyAwaiter<T>*, std::hash<IEvent::Key_t>, std::equal_to<>,
+                                        PoolAllocator<std::pair<const IEvent::Key_t, ReplyAwaiter<T>*>>>;
+
+public:
+    PendingReplies() = default;
+    PendingReplies(const PendingReplies&) = delete;
+    PendingReplies& operator=(const PendingReplies&) = delete;
+
+    ~PendingReplies() override
+    {
+        while (!m_waiting.empty())
+        {
+            m_waiting.begin()->second->detach();
+        }
+        if (m_unsubscriber)
+        {
+            m_unsubscriber();
+        }
+    }
+
+    inline void setUnsubscriber(std::function<void()> unsubscriber)
+    {
+        m_unsubscriber = std::move(unsubscriber);
+    }
+
+private:
+    void notify(const IEvent& event) override
+    {
+        const auto& reply = static_cast<const Reply<T>&>(event);
+        if (auto awaiter = find(reply.correlationId))
+        {
+            awaiter->receive(reply.event);
+        }
+    }
+
+    void notify(IEvent&& event) override
+    {
+        auto& reply = static_cast<Reply<T>&>(event);
+        if (auto awaiter = find(reply.correlationId))
+        {
+            awaiter->receive(std::move(reply.event));
+        }
+    }
+
+    inline ReplyAwaiter<T>* find(IEvent::Key_t correlationId) const
+    {
+        auto awaiter = m_waiting.find(correlationId);
+        return awaiter != m_waiting.end() ? awaiter->second : nullptr;
+    }
+
+private:
+    Awaiters m_waiting;
+    std::function<void()> m_unsubscriber;
+};
+
+}  // namespace easy
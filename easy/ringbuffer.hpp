@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace easy
+{
+
+/**
+ * FIFO queue on a circular buffer. Storage grows when the queue is full and is never released,
+ * so a queue which has reached its working size does not allocate anymore.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+    inline void push(T value)
+    {
+        if (m_size == m_items.size())
+        {
+            grow();
+        }
+        m_items[(m_head + m_size) & (m_items.size() - 1)] = std::move(value);
+        ++m_size;
+    }
+
+    inline void pop()
+    {
+        m_items[m_head] = T{};
+        m_head = (m_head + 1) & (m_items.size() - 1);
+        --m_size;
+    }
+
+    inline T& front()
+    {
+        return m_items[m_head];
+    }
+
+    inline const T& front() const
+    {
+        return m_items[m_head];
+    }
+
+    inline T& operator[](std::size_t position)
+    {
+        return m_items[(m_head + position) & (m_items.size() - 1)];
+    }
+
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+    inline bool empty() const
+    {
+        return m_size == 0;
+    }
+
+private:
+    void grow()
+    {
+        auto items = std::vector<T>(m_items.empty() ? INITIAL_CAPACITY : 2 * m_items.size());
+        for (auto i = std::size_t{}; i < m_size; ++i)
+        {
+            items[i] = std::move(m_items[(m_head + i) & (m_items.size() - 1)]);
+        }
+        m_items = std::move(items);
+        m_head = 0;
+    }
+
+private:
+    static constexpr auto INITIAL_CAPACITY = std::size_t{16};
+
+    std::vector<T> m_items;
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+};
+
+}  // namespace easy
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace easy
+{
+
+/**
+ * Values kept in a dense array, addressed by generation checked handles.
+ * Insert and erase are O(1), erase moves the last value into the freed place,
+ * so iteration order is not preserved after it. eraseOrdered keeps insertion order
+ * at O(n) cost.
+ */
+template <typename T>
+class SlotMap
+{
+public:
+    struct Handle
+    {
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+
+private:
+    struct Slot
+    {
+        uint32_t valueIndex = 0;
+        uint32_t generation = 0;
+    };
+
+public:
+    inline Handle insert(T value)
+    {
+        auto slotIndex = uint32_t{};
+        if (!m_freeSlots.empty())
+        {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        auto& slot = m_slots[slotIndex];
+        slot.valueIndex = static_cast<uint32_t>(m_values.size());
+        m_values.push_back(std::move(value));
+        m_valueSlots.push_back(slotIndex);
+        return Handle{slotIndex, slot.generation};
+    }
+
+    inline bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        auto& slot = m_slots[handle.index];
+        const auto lastIndex = m_values.size() - 1;
+        if (slot.valueIndex != lastIndex)
+        {
+            m_values[slot.valueIndex] = std::move(m_values[lastIndex]);
+            m_valueSlots[slot.valueIndex] = m_valueSlots[lastIndex];
+            m_slots[m_valueSlots[slot.valueIndex]].valueIndex = slot.valueIndex;
+        }
+        m_values.pop_back();
+        m_valueSlots.pop_back();
+        release(handle.index);
+        return true;
+    }
+
+    inline bool eraseOrdered(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        const auto valueIndex = m_slots[handle.index].valueIndex;
+        m_values.erase(m_values.begin() + valueIndex);
+        m_valueSlots.erase(m_valueSlots.begin() + valueIndex);
+        for (auto i = valueIndex; i < m_valueSlots.size(); ++i)
+        {
+            m_slots[m_valueSlots[i]].valueIndex = i;
+        }
+        release(handle.index);
+        return true;
+    }
+
+    inline bool contains(Handle handle) const
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+    }
+
+    inline T* find(Handle handle)
+    {
+        return contains(handle) ? &m_values[m_slots[handle.index].valueIndex] : nullptr;
+    }
+
+    inline T& operator[](std::size_t index)
+    {
+        return m_values[index];
+    }
+
+    inline const T& operator[](std::size_t index) const
+    {
+        return m_values[index];
+    }
+
+    inline auto begin() { return m_values.begin(); }
+    inline auto begin() const { return m_values.begin(); }
+    inline auto end() { return m_values.end(); }
+    inline auto end() const { return m_values.end(); }
+
+    inline std::size_t size() const
+    {
+        return m_values.size();
+    }
+
+    inline bool empty() const
+    {
+        return m_values.empty();
+    }
+
+private:
+    inline void release(uint32_t slotIndex)
+    {
+        ++m_slots[slotIndex].generation;
+        m_freeSlots.push_back(slotIndex);
+    }
+
+private:
+    std::vector<T> m_values;
+    std::vector<uint32_t> m_valueSlots;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+}  // namespace easy
@@ -0,0 +1,94 @@
+#include "strand.hpp"
+
+#include <algorithm>
+
+#include "executor.hpp"
+#include "notifier.hpp"
+#include "notifierpool.hpp"
+
+
+namespace easy
+{
+
+Strand::Strand(Executor& executor)
+    : m_executor{executor}
+    , m_context{NotifiersPool::createContext(*this)}
+{}
+
+Strand::~Strand()
+{
+    {
+        std::unique_lock lock(m_idleMutex);
+        m_idleCondition.wait(lock, [this]() {
+            return !m_isScheduled.exchange(true);    // keeps the strand from being scheduled again
+        });
+    }
+    m_executor.unschedule(*this);
+    NotifiersPool::teardown(m_context);
+}
+
+void Strand::schedule()
+{
+    if (!m_isScheduled.exchange(true))
+    {
+        m_executor.schedule(*this);
+    }
+}
+
+void Strand::scheduleAt(std::chrono::steady_clock::time_point time)
+{
+    std::lock_guard lock(m_idleMutex);
+    if (!m_wakeUpTime || time < *m_wakeUpTime || *m_wakeUpTime <= std::chrono::steady_clock::now())
+    {
+        m_wakeUpTime = time;    // later deadlines are rescheduled by the run at the earlier one
+        m_executor.scheduleAt(*this, time);
+    }
+}
+
+void Strand::run()
+{
+    m_tasks.consume([](std::function<void()>&& task) { task(); });
+
+    auto dispatched = std::size_t{};
+    do
+    {
+        for (auto i = std::size_t{}; i < m_notifiers.size(); ++i)    // subscribers may create or destroy notifiers
+        {
+            dispatched += m_notifiers[i]->dispatch(EVENTS_PER_RUN);
+        }
+    } while (dispatched < EVENTS_PER_RUN && m_context.proxy.hasQueuedEvents());
+
+    const auto isWorkLeft = dispatched >= EVENTS_PER_RUN;
+    auto wakeUpTime = std::optional<std::chrono::steady_clock::time_point>{};
+    for (auto notifier : m_notifiers)
+    {
+        const auto expiry = notifier->nextTimerExpiry();
+        if (expiry && (!wakeUpTime || *expiry < *wakeUpTime))
+            wakeUpTime = expiry;
+    }
+    if (wakeUpTime)
+    {
+        scheduleAt(*wakeUpTime);
+    }
+
+    std::lock_guard lock(m_idleMutex);
+    m_isScheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);    // pairs with fence in NotifierThreadContext::wakeUp
+    if ((isWorkLeft || !m_tasks.empty() || m_context.hasEvents()) && !m_isScheduled.exchange(true))
+    {
+        m_executor.schedule(*this);
+    }
+    m_idleCondition.notify_all();
+}
+
+void Strand::attach(Notifier& notifier)
+{
+    m_notifiers.push_back(&notifier);
+}
+
+void Strand::detach(Notifier& notifier)
+{
+    std::erase(m_notifiers, &notifier);
+}
+
+}  // namespace easy
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "ischeduler.hpp"
+#include "mpscqueue.hpp"
+#include "notifierthreadcontext.hpp"
+
+
+namespace easy
+{
+
+class Executor;
+class Notifier;
+
+/**
+ * Serialized mailbox of notifiers, run by executor workers instead of a dedicated thread.
+ * Whenever events or tasks arrive, the strand is scheduled and one worker at a time dispatches
+ * all its notifiers. Notifiers of the strand and their subscribers should be created and destroyed
+ * by tasks posted to the strand, or before events are published to them. Timers of the notifiers
+ * schedule the strand at their expiry. Strand must be destroyed after its notifiers and before the executor.
+ */
+class Strand : private IScheduler
+{
+    friend class Executor;
+    friend class Notifier;
+
+public:
+    explicit Strand(Executor& executor);
+    ~Strand();
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+    Strand(Strand&&) = delete;
+    Strand& operator=(Strand&&) = delete;
+
+    template <typename Function>
+    void post(Function&& function)
+    {
+        m_tasks.push(std::function<void()>(std::forward<Function>(function)));
+        schedule();
+    }
+
+private:
+    void schedule() override;
+    void scheduleAt(std::chrono::steady_clock::time_point time);
+    void run();
+
+    void attach(Notifier& notifier);
+    void detach(Notifier& notifier);
+
+private:
+    static constexpr auto EVENTS_PER_RUN = std::size_t{256};    // then other strands get the worker
+
+    Executor& m_executor;
+    NotifierThreadContext& m_context;
+    MpscQueue<std::function<void()>> m_tasks;
+    std::vector<Notifier*> m_notifiers;
+    std::atomic_bool m_isScheduled = false;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition;
+    std::optional<std::chrono::steady_clock::time_point> m_wakeUpTime;    // guarded by m_idleMutex
+};
+
+}  // namespace easy
@@ -3,6 +3,10 @@
  */
 #pragma once
 
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+
 #include "isubscription.hpp"
 #include "notifier.hpp"
 
@@ -10,12 +14,42 @@
 namespace easy
 {
 
+/**
+ * Passes delivered events of type T to onEvent.
+ */
+template <typename T>
+class EventHandler : protected ISubscription
+{
+protected:
+    virtual void onEvent(const T& event) = 0;
+
+    /**
+     * Called instead of onEvent(const T&) when the subscriber is the last owner of the event
+     * and may take its content. Delegates to onEvent(const T&) unless overridden.
+     */
+    virtual void onEvent(T&& event) { onEvent(static_cast<const T&>(event)); }
+
+private:
+    void notify(const IEvent& event) override
+    {
+        assert(dynamic_cast<const T*>(&event) && "Notifier delivers only events of subscribed type");
+        onEvent(static_cast<const T&>(event));
+    }
+
+    void notify(IEvent&& event) override
+    {
+        assert(dynamic_cast<const T*>(&event) && "Notifier delivers only events of subscribed type");
+        onEvent(static_cast<T&&>(event));
+    }
+};
+
+
 template <typename T>
-class Subscription : private ISubscription
+class Subscription : public EventHandler<T>
 {
 public:
-    Subscription(Notifier& notifier)
-        : m_unsubscriber{notifier.subscribe<T>(this)}
+    Subscription(Notifier& notifier, std::function<bool(const T&)> filter = {})
+        : m_unsubscriber{notifier.subscribe<T>(this, std::move(filter))}
     {}
 
     Subscription(const Subscription&) = delete;
@@ -31,17 +65,61 @@ public:
         }
     }
 
-protected:
-    virtual void onEvent(const T& event) = 0;
-
 private:
-    void notify(const IEvent& event) override
+    std::function<void()> m_unsubscriber;
+};
+
+
+/**
+ * Subscription only for selected topics of event type T, added by Subscribe::subscribeTopic.
+ */
+template <typename T>
+struct Topic {};
+
+template <typename T>
+class Subscription<Topic<T>> : public EventHandler<T>
+{
+public:
+    Subscription(Notifier& notifier, std::function<bool(const T&)> filter = {})
+        : m_notifier{notifier}
+        , m_filter{std::move(filter)}
+    {}
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+    Subscription(Subscription&& subscription) = delete;
+    Subscription& operator=(Subscription&& subscription) = delete;
+
+    virtual ~Subscription()
     {
-        onEvent(dynamic_cast<const T&>(event));
+        for (auto& [topic, unsubscriber] : m_unsubscribers)
+        {
+            unsubscriber();
+        }
+    }
+
+    inline void subscribeTopic(IEvent::Key_t topic)
+    {
+        if (!m_unsubscribers.contains(topic))
+        {
+            m_unsubscribers.emplace(topic, m_notifier.subscribe<T>(this, topic, m_filter));
+        }
+    }
+
+    inline void unsubscribeTopic(IEvent::Key_t topic)
+    {
+        auto unsubscriber = m_unsubscribers.find(topic);
+        if (unsubscriber != m_unsubscribers.end())
+        {
+            unsubscriber->second();
+            m_unsubscribers.erase(unsubscriber);
+        }
     }
 
 private:
-    std::function<void()> m_unsubscriber;
+    Notifier& m_notifier;
+    std::function<bool(const T&)> m_filter;
+    std::unordered_map<IEvent::Key_t, std::function<void()>> m_unsubscribers;
 };
 
 
@@ -54,16 +132,58 @@ public:
         , m_notifier{notifier}
     {}
 
+    /**
+     * Subscribes with one filter per event type, nullptr for types which are not filtered.
+     */
+    template <typename... Filters, typename = std::enable_if_t<sizeof...(Filters) == sizeof...(Args)>>
+    Subscribe(Notifier& notifier, Filters&&... filters)
+        : Subscription<Args>{notifier, std::forward<Filters>(filters)}...
+        , m_notifier{notifier}
+    {}
+
     Subscribe(const Subscribe&) = delete;
     Subscribe& operator=(const Subscribe&) = delete;
     Subscribe(Subscribe&&) = delete;
     Subscribe& operator=(Subscribe&&) = delete;
 
+    /**
+     * Adds topic of event type T, subscribed with Topic<T>.
+     */
+    template <typename T>
+    inline void subscribeTopic(IEvent::Key_t topic)
+    {
+        Subscription<Topic<T>>::subscribeTopic(topic);
+    }
+
+    template <typename T>
+    inline void unsubscribeTopic(IEvent::Key_t topic)
+    {
+        Subscription<Topic<T>>::unsubscribeTopic(topic);
+    }
+
 protected:
     template <typename T>
-    inline void publish(T event)
+    inline PublishStatus publish(T event)
+    {
+        return m_notifier.publish(std::move(event));
+    }
+
+    template <typename R, typename T>
+    inline PublishStatus reply(const Request<T>& request, R event)
+    {
+        return m_notifier.reply(request, std::move(event));
+    }
+
+    template <typename T, typename... EventArgs>
+    inline PublishStatus emplace(EventArgs&&... args)
+    {
+        return m_notifier.template emplace<T>(std::forward<EventArgs>(args)...);
+    }
+
+    template <typename Range>
+    inline PublishStatus publishBatch(Range&& events)
     {
-        m_notifier.publish(std::move(event));
+        return m_notifier.publishBatch(std::forward<Range>(events));
     }
 
 private:
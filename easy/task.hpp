@@ -0,0 +1,72 @@
+#pragma once
+
+#include <coroutine>
+#include <utility>
+
+
+namespace easy
+{
+
+/**
+ * Coroutine which starts immediately and is owned by the returned task. Destroying the task
+ * destroys the coroutine, also while it awaits an event. Exceptions leave the coroutine to
+ * the code which resumed it, usually Notifier::dispatch().
+ */
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object() { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { throw; }
+    };
+
+    Task() = default;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept
+        : m_coroutine{std::exchange(other.m_coroutine, nullptr)}
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        reset();
+    }
+
+    inline bool isDone() const
+    {
+        return !m_coroutine || m_coroutine.done();
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> coroutine)
+        : m_coroutine{coroutine}
+    {}
+
+    inline void reset()
+    {
+        if (m_coroutine)
+        {
+            std::exchange(m_coroutine, nullptr).destroy();
+        }
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_coroutine;
+};
+
+}  // namespace easy
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "poolallocator.hpp"
+#include "slotmap.hpp"
+
+
+namespace easy
+{
+
+/**
+ * Hierarchical timing wheel of values due at given ticks. Insert and cancel are O(1), values
+ * kept on higher levels are moved down when the wheel turns, so each one is moved at most once per level.
+ * Ticks without work on lower levels are skipped. Periodic values stay in the wheel and are due
+ * every period after the first expiry. Each is passed at most once per advance, missed periods are skipped.
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+    using Tick = uint64_t;
+
+private:
+    struct Node;
+    using Handles = SlotMap<Node*>;
+
+public:
+    using Handle = typename Handles::Handle;
+
+private:
+    static constexpr auto SLOT_BITS = 8u;
+    static constexpr auto SLOTS = std::size_t{1} << SLOT_BITS;
+    static constexpr auto LEVELS = std::size_t{4};
+
+    struct Node
+    {
+        T value;
+        Tick expiry;
+        Tick period = 0;
+        Handle handle;
+        std::size_t level = 0;
+        Node** slot = nullptr;
+        Node* previous = nullptr;
+        Node* next = nullptr;
+    };
+
+    using NodesPool = MemoryPool<sizeof(Node), alignof(Node)>;
+
+public:
+    TimerWheel() = default;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    ~TimerWheel()
+    {
+        for (auto node : m_handles)
+        {
+            destroyNode(node);
+        }
+    }
+
+    /**
+     * Values due at the current or past tick are passed by the next advance.
+     */
+    inline Handle insert(Tick expiry, T value, Tick period = 0)
+    {
+        auto node = new (NodesPool::allocate()) Node{std::move(value), std::max(expiry, m_currentTick + 1), period};
+        node->handle = m_handles.insert(node);
+        place(node);
+        return node->handle;
+    }
+
+    inline bool cancel(Handle handle)
+    {
+        auto node = m_handles.find(handle);
+        if (!node)
+            return false;
+
+        auto cancelled = *node;
+        m_handles.erase(handle);
+        if (!cancelled->slot)
+            return true;    // periodic value being passed, destroyed by advance
+
+        unlink(cancelled);
+        destroyNode(cancelled);
+        return true;
+    }
+
+    /**
+     * Turns the wheel up to the tick and passes every due value to the function as an lvalue,
+     * the function may move out values which are not periodic. The function may insert and cancel timers.
+     */
+    template <typename Function>
+    std::size_t advance(Tick now, Function&& function)
+    {
+        auto expired = std::size_t{};
+        while (m_currentTick < now && !empty())
+        {
+            m_currentTick = std::min(nextWorkTick(), now);
+            for (auto level = std::size_t{1}; level < LEVELS && (m_currentTick & levelMask(level)) == 0; ++level)
+            {
+                cascade(m_slots[level][slotIndex(m_currentTick, level)]);
+            }
+
+            auto& slot = m_slots[0][slotIndex(m_currentTick, 0)];
+            while (auto node = slot)
+            {
+                unlink(node);
+                ++expired;
+                if (node->period)
+                {
+                    passPeriodic(node, function, now);
+                    continue;
+                }
+
+                m_handles.erase(node->handle);
+                auto value = std::move(node->value);
+                destroyNode(node);
+                function(value);
+            }
+        }
+
+        if (empty() && m_currentTick < now)
+        {
+            m_currentTick = now;
+        }
+        return expired;
+    }
+
+    /**
+     * Tick at which advance should be called next, not later than the earliest due value.
+     */
+    inline std::optional<Tick> nextExpiry() const
+    {
+        if (empty())
+            return std::nullopt;
+
+        return nextWorkTick();
+    }
+
+    inline Tick currentTick() const
+    {
+        return m_currentTick;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_handles.size();
+    }
+
+    inline bool empty() const
+    {
+        return m_handles.empty();
+    }
+
+private:
+    static constexpr Tick levelMask(std::size_t level)
+    {
+        return (Tick{1} << (SLOT_BITS * level)) - 1;
+    }
+
+    static constexpr std::size_t slotIndex(Tick tick, std::size_t level)
+    {
+        return static_cast<std::size_t>(tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    }
+
+    /**
+     * The nearest tick with due values on the lowest level, or with values to move down from higher levels.
+     */
+    inline Tick nextWorkTick() const
+    {
+        auto level = std::size_t{};
+        while (m_levelSizes[level] == 0)
+        {
+            ++level;
+        }
+
+        const auto cascadeTick = (m_currentTick | levelMask(level + 1)) + 1;    // higher levels are not due before
+        if (level > 0)
+            return (m_currentTick | levelMask(level)) + 1;
+
+        for (auto tick = m_currentTick + 1; tick < cascadeTick; ++tick)
+        {
+            if (m_slots[0][slotIndex(tick, 0)])
+                return tick;
+        }
+        return cascadeTick;
+    }
+
+    template <typename Function>
+    void passPeriodic(Node* node, Function& function, Tick now)
+    {
+        node->slot = nullptr;
+        try
+        {
+            function(node->value);
+        }
+        catch (...)
+        {
+            rearm(node, now);
+            throw;
+        }
+        rearm(node, now);
+    }
+
+    inline void rearm(Node* node, Tick now)
+    {
+        if (!m_handles.contains(node->handle))
+        {
+            destroyNode(node);    // cancelled while passed
+            return;
+        }
+
+        const auto missedPeriods = (now - node->expiry) / node->period;
+        node->expiry += (missedPeriods + 1) * node->period;
+        place(node);
+    }
+
+    static inline void destroyNode(Node* node)
+    {
+        node->~Node();
+        NodesPool::deallocate(node);
+    }
+
+    inline void place(Node* node)
+    {
+        const auto delay = node->expiry - m_currentTick;
+        auto level = std::size_t{};
+        while (level + 1 < LEVELS && delay > levelMask(level + 1))
+        {
+            ++level;
+        }
+
+        auto& slot = m_slots[level][slotIndex(node->expiry, level)];
+        node->level = level;
+        ++m_levelSizes[level];
+        node->slot = &slot;
+        node->previous = nullptr;
+        node->next = slot;
+        if (slot)
+        {
+            slot->previous = node;
+        }
+        slot = node;
+    }
+
+    inline void unlink(Node* node)
+    {
+        --m_levelSizes[node->level];
+        if (node->previous)
+            node->previous->next = node->next;
+        else
+            *node->slot = node->next;
+
+        if (node->next)
+        {
+            node->next->previous = node->previous;
+        }
+    }
+
+    inline void cascade(Node*& slot)
+    {
+        auto node = std::exchange(slot, nullptr);    // values may go back to the same slot of the top level
+        while (node)
+        {
+            --m_levelSizes[node->level];
+            place(std::exchange(node, node->next));
+        }
+    }
+
+private:
+    std::array<std::array<Node*, SLOTS>, LEVELS> m_slots = {};
+    std::array<std::size_t, LEVELS> m_levelSizes = {};
+    Handles m_handles;
+    Tick m_currentTick = 0;
+};
+
+}  // namespace easy
@@ -105,7 +105,7 @@ void advanced_example()
         auto notifier = easy::Notifier{};
         auto observer = SensorObserver(notifier);
         while (observer.isWorking)
-            notifier.dispatch();
+            notifier.waitAndDispatch();
     });
 
     auto t2 = std::thread([](){
@@ -113,7 +113,7 @@ void advanced_example()
         auto valueReceiver = SensorValueReceiver(notifier);
         valueReceiver.checkData();
         while (valueReceiver.isWorking)
-            notifier.dispatch();
+            notifier.waitAndDispatch();
     });
 
     if (t1.joinable())
@@ -59,8 +59,8 @@ void simple_example()
     {
         std::cout << "Enter phrase ('q' or 'quit' to exit): \n";
         std::cin >> phrase;
-        notifier.publish(InputEvent{phrase});    // publishing an event
-        subscriberNotifier.dispatch();           // dispatch all events notifier is aware of to subscribers
+        notifier.emplace<InputEvent>(phrase);    // publishing an event constructed in place
+        subscriberNotifier.dispatchAll();        // dispatch all events notifier is aware of to subscribers
     }
 }
 
@@ -0,0 +1,132 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/subscriber.hpp"
+#include "easy/notifier.hpp"
+#include "easy/task.hpp"
+
+#include <vector>
+
+
+namespace coroutines
+{
+
+class DemandSensorDataEvent : public easy::Event<DemandSensorDataEvent> {};
+
+class SensorReadEvent : public easy::Event<SensorReadEvent>
+{
+public:
+    SensorReadEvent(int data) : data{data} {}
+
+public:
+    int data = {};
+};
+
+class SensorObserver : public easy::Subscribe<DemandSensorDataEvent>
+{
+public:
+    SensorObserver(easy::Notifier& notifier) : easy::Subscribe<DemandSensorDataEvent>{notifier} {}
+    void onEvent(const DemandSensorDataEvent&) { publish(SensorReadEvent(value)); value += 100; }
+
+public:
+    int value = 0;
+};
+
+
+easy::Task readUntil(easy::Notifier& notifier, int threshold, std::vector<int>& values)
+{
+    auto value = -1;
+    while (value < threshold)
+    {
+        auto reply = notifier.next<SensorReadEvent>();    // awaited before the request is published
+        notifier.publish(DemandSensorDataEvent());
+        value = (co_await reply).data;
+        values.push_back(value);
+    }
+}
+
+easy::Task receive(easy::Notifier& notifier, std::vector<int>& values, int count)
+{
+    for (auto i = 0; i < count; ++i)
+    {
+        const auto event = co_await notifier.next<SensorReadEvent>();
+        values.push_back(event.data);
+    }
+}
+
+
+TEST_CASE("Coroutine is resumed by dispatch of awaited event", "[single_thread][coroutines]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto values = std::vector<int>{};
+    auto task = receive(notifier, values, 2);
+    REQUIRE_FALSE(task.isDone());
+
+    notifierBase.publish(SensorReadEvent(1));
+    notifierBase.publish(SensorReadEvent(2));
+    notifierBase.publish(SensorReadEvent(3));
+    REQUIRE(values.empty());
+
+    REQUIRE(notifier.dispatchAll() == 3u);
+    REQUIRE(values == std::vector{1, 2});
+    REQUIRE(task.isDone());
+};
+
+TEST_CASE("Coroutine awaits replies to its requests", "[single_thread][coroutines]")
+{
+    easy::Notifier observerNotifier;
+    easy::Notifier notifier;
+    auto observer = SensorObserver(observerNotifier);
+
+    auto values = std::vector<int>{};
+    auto task = readUntil(notifier, 250, values);
+
+    while (!task.isDone())
+    {
+        REQUIRE(observerNotifier.dispatchAll() == 1u);
+        REQUIRE(notifier.dispatchAll() == 1u);
+    }
+    REQUIRE(values == std::vector{0, 100, 200, 300});
+};
+
+TEST_CASE("All coroutines awaiting the event are resumed", "[single_thread][coroutines]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto values = std::vector<int>{};
+    auto values2 = std::vector<int>{};
+    auto task = receive(notifier, values, 1);
+    auto task2 = receive(notifier, values2, 2);
+
+    notifierBase.publish(SensorReadEvent(1));
+    notifierBase.publish(SensorReadEvent(2));
+    notifier.dispatchAll();
+
+    REQUIRE(task.isDone());
+    REQUIRE(task2.isDone());
+    REQUIRE(values == std::vector{1});
+    REQUIRE(values2 == std::vector{1, 2});
+};
+
+TEST_CASE("Destroyed coroutine does not await event anymore", "[single_thread][coroutines]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto values = std::vector<int>{};
+    auto values2 = std::vector<int>{};
+    auto task = receive(notifier, values, 1);
+    {
+        auto task2 = receive(notifier, values2, 1);
+    }
+
+    notifierBase.publish(SensorReadEvent(1));
+    notifier.dispatchAll();
+
+    REQUIRE(task.isDone());
+    REQUIRE(values == std::vector{1});
+    REQUIRE(values2.empty());
+};
+
+}  // namespace coroutines
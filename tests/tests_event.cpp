@@ -0,0 +1,88 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/event.hpp"
+#include "easy/notifier.hpp"
+#include "easy/subscriber.hpp"
+
+#include <set>
+
+
+namespace event
+{
+
+class FirstEvent : public easy::Event<FirstEvent> {};
+class SecondEvent : public easy::Event<SecondEvent> {};
+
+template <typename T>
+class TemplateEvent : public easy::Event<TemplateEvent<T>> {};
+
+static_assert(FirstEvent::UUID() != SecondEvent::UUID());
+static_assert(TemplateEvent<int>::UUID() != TemplateEvent<long>::UUID());
+
+class DerivedEvent : public FirstEvent {};
+
+static_assert(easy::EventType<FirstEvent>);
+static_assert(easy::EventType<TemplateEvent<int>>);
+static_assert(!easy::EventType<DerivedEvent>);    // shares UUID and index of FirstEvent
+
+namespace
+{
+
+class PingEvent : public easy::Event<PingEvent> {};
+
+class PingSubscriber : public easy::Subscribe<PingEvent>
+{
+public:
+    PingSubscriber(easy::Notifier& notifier) : easy::Subscribe<PingEvent>{notifier} {}
+    void onEvent(const PingEvent&) { ++calledTimes; }
+
+public:
+    unsigned calledTimes = 0;
+};
+
+}  // namespace
+
+easy::IEvent::UUID_t otherUnitPingUuid();
+easy::IEvent::Index_t otherUnitPingIndex();
+void publishOtherUnitPing(easy::Notifier& notifier);
+
+
+TEST_CASE("Event UUID is a compile time constant of the type", "[event]")
+{
+    constexpr auto uuid = FirstEvent::UUID();
+
+    REQUIRE(FirstEvent().uuid() == uuid);
+    REQUIRE(SecondEvent().uuid() == SecondEvent::UUID());
+    REQUIRE(SecondEvent().uuid() != uuid);
+};
+
+TEST_CASE("Event indexes are distinct for each event type", "[event]")
+{
+    const auto indexes = std::set{
+        FirstEvent::INDEX(),
+        SecondEvent::INDEX(),
+        TemplateEvent<int>::INDEX(),
+        TemplateEvent<long>::INDEX()
+    };
+
+    REQUIRE(indexes.size() == 4u);
+    REQUIRE(FirstEvent().index() == FirstEvent::INDEX());
+    REQUIRE(TemplateEvent<int>().index() == TemplateEvent<int>::INDEX());
+};
+
+TEST_CASE("Events of the same name in different translation units are distinct", "[event]")
+{
+    REQUIRE(PingEvent::UUID() == otherUnitPingUuid());    // names of both types are equal
+    REQUIRE(PingEvent::INDEX() != otherUnitPingIndex());
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = PingSubscriber(notifier);
+
+    publishOtherUnitPing(notifierBase);
+    REQUIRE(notifier.dispatchAll() == 0u);
+    notifierBase.publish(PingEvent());
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.calledTimes == 1u);
+};
+
+}  // namespace event
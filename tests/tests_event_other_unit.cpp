@@ -0,0 +1,30 @@
+#include "easy/notifier.hpp"
+
+
+namespace event
+{
+
+namespace
+{
+
+class PingEvent : public easy::Event<PingEvent> {};    // same name as the event of tests_event.cpp
+
+}  // namespace
+
+
+easy::IEvent::UUID_t otherUnitPingUuid()
+{
+    return PingEvent::UUID();
+}
+
+easy::IEvent::Index_t otherUnitPingIndex()
+{
+    return PingEvent::INDEX();
+}
+
+void publishOtherUnitPing(easy::Notifier& notifier)
+{
+    notifier.publish(PingEvent());
+}
+
+}  // namespace event
@@ -0,0 +1,95 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/eventstorage.hpp"
+
+#include <array>
+#include <utility>
+
+
+namespace event_storage
+{
+
+int liveEvents = 0;
+
+class SmallEvent : public easy::Event<SmallEvent>
+{
+public:
+    SmallEvent(int data) : data{data} { ++liveEvents; }
+    SmallEvent(const SmallEvent& other) noexcept : data{other.data} { ++liveEvents; }
+    ~SmallEvent() { --liveEvents; }
+
+public:
+    int data = {};
+};
+
+class LargeEvent : public easy::Event<LargeEvent>
+{
+public:
+    LargeEvent(int data) : data{} { this->data.fill(data); ++liveEvents; }
+    LargeEvent(const LargeEvent& other) noexcept : data{other.data} { ++liveEvents; }
+    ~LargeEvent() { --liveEvents; }
+
+public:
+    std::array<int, 64> data = {};
+};
+
+static_assert(easy::EventStorage::isStoredInline<SmallEvent>);
+static_assert(!easy::EventStorage::isStoredInline<LargeEvent>);
+
+
+TEST_CASE("Event storage is empty on initialization", "[event_storage]")
+{
+    auto storage = easy::EventStorage{};
+    REQUIRE_FALSE(storage);
+    REQUIRE(storage.get() == nullptr);
+    REQUIRE_FALSE(storage.isInline());
+};
+
+TEST_CASE("Small event is copied into every storage", "[event_storage]")
+{
+    {
+        auto storage = easy::EventStorage(SmallEvent(7));
+        REQUIRE(storage.isInline());
+        REQUIRE(liveEvents == 1);
+
+        auto copy = storage;
+        REQUIRE(copy.get() != storage.get());
+        REQUIRE(static_cast<SmallEvent&>(*copy).data == 7);
+        REQUIRE(liveEvents == 2);
+
+        auto moved = std::move(copy);
+        REQUIRE_FALSE(copy);
+        REQUIRE(moved->index() == SmallEvent::INDEX());
+        REQUIRE(static_cast<SmallEvent&>(*moved).data == 7);
+        REQUIRE(liveEvents == 2);
+
+        moved.reset();
+        REQUIRE_FALSE(moved);
+        REQUIRE(liveEvents == 1);
+    }
+    REQUIRE(liveEvents == 0);
+};
+
+TEST_CASE("Large event is shared between storages", "[event_storage]")
+{
+    {
+        auto storage = easy::EventStorage(LargeEvent(3));
+        REQUIRE_FALSE(storage.isInline());
+
+        auto copy = storage;
+        REQUIRE(copy.get() == storage.get());
+        REQUIRE(liveEvents == 1);
+
+        auto moved = easy::EventStorage{};
+        moved = std::move(copy);
+        REQUIRE_FALSE(copy);
+        REQUIRE(moved.get() == storage.get());
+        REQUIRE(static_cast<LargeEvent&>(*moved).data[63] == 3);
+
+        storage = easy::EventStorage(SmallEvent(1));
+        REQUIRE(storage.isInline());
+        REQUIRE(liveEvents == 2);
+    }
+    REQUIRE(liveEvents == 0);
+};
+
+}  // namespace event_storage
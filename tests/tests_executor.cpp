@@ -0,0 +1,256 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/executor.hpp"
+#include "easy/strand.hpp"
+#include "easy/subscriber.hpp"
+#include "easy/notifier.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace executor
+{
+
+class PingEvent : public easy::Event<PingEvent>
+{
+public:
+    PingEvent(int value = 0) : value{value} {}
+
+public:
+    int value = {};
+};
+
+class PongEvent : public easy::Event<PongEvent> {};
+
+class PingSubscriber : public easy::Subscribe<PingEvent>
+{
+public:
+    PingSubscriber(easy::Notifier& notifier) : easy::Subscribe<PingEvent>{notifier} {}
+    void onEvent(const PingEvent&)
+    {
+        isSerial = isSerial && ++inFlight == 1;
+        std::this_thread::yield();
+        --inFlight;
+        ++calledTimes;
+    }
+
+public:
+    std::atomic_int inFlight = 0;
+    std::atomic_bool isSerial = true;
+    std::atomic_uint calledTimes = 0;
+};
+
+class PingPongSubscriber : public easy::Subscribe<PingEvent, PongEvent>
+{
+public:
+    PingPongSubscriber(easy::Notifier& notifier) : easy::Subscribe<PingEvent, PongEvent>{notifier} {}
+    void onEvent(const PingEvent&) { publish(PongEvent()); }
+    void onEvent(const PongEvent&) { ++pongs; }
+
+public:
+    std::atomic_uint pongs = 0;
+};
+
+struct Component
+{
+    Component(easy::Strand& strand) : notifier{strand}, subscriber{notifier} {}
+
+    easy::Notifier notifier;
+    PingSubscriber subscriber;
+};
+
+template <typename Function>
+void runOn(easy::Strand& strand, Function&& function)
+{
+    auto done = std::promise<void>{};
+    strand.post([&function, &done]() {
+        function();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+template <typename Predicate>
+bool waitUntil(Predicate&& predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+
+TEST_CASE("Strand runs posted tasks", "[executor]")
+{
+    easy::Executor executor(2);
+    easy::Strand strand(executor);
+
+    auto executed = std::atomic_uint{};
+    for (auto i = 0; i < 100; ++i)
+        strand.post([&executed]() { ++executed; });
+
+    REQUIRE(waitUntil([&executed]() { return executed == 100u; }));
+};
+
+TEST_CASE("Strand dispatches events published from different thread", "[executor][multiple_threads]")
+{
+    const auto EVENTS_SENT = 1000u;
+
+    easy::Executor executor(2);
+    easy::Strand strand(executor);
+
+    auto component = std::unique_ptr<Component>{};
+    runOn(strand, [&component, &strand]() { component = std::make_unique<Component>(strand); });
+
+    easy::Notifier notifier;
+    for (auto i = 0u; i < EVENTS_SENT; ++i)
+        notifier.publish(PingEvent(i));
+
+    REQUIRE(waitUntil([&component]() { return component->subscriber.calledTimes == EVENTS_SENT; }));
+    runOn(strand, [&component]() { component.reset(); });
+};
+
+TEST_CASE("Each strand dispatches its events serially", "[executor][multiple_threads]")
+{
+    const auto STRANDS = 50u;
+    const auto PUBLISHERS = 4u;
+    const auto EVENTS_SENT = 200u;
+
+    easy::Executor executor(4);
+    auto strands = std::vector<std::unique_ptr<easy::Strand>>{};
+    auto components = std::vector<std::unique_ptr<Component>>(STRANDS);
+    for (auto i = 0u; i < STRANDS; ++i)
+    {
+        auto& strand = *strands.emplace_back(std::make_unique<easy::Strand>(executor));
+        runOn(strand, [&component = components[i], &strand]() { component = std::make_unique<Component>(strand); });
+    }
+
+    auto publishers = std::vector<std::thread>{};
+    for (auto i = 0u; i < PUBLISHERS; ++i)
+    {
+        publishers.emplace_back([]() {
+            easy::Notifier notifier;
+            for (auto j = 0u; j < EVENTS_SENT; ++j)
+                notifier.publish(PingEvent(j));
+        });
+    }
+    for (auto& publisher : publishers)
+        publisher.join();
+
+    for (auto i = 0u; i < STRANDS; ++i)
+    {
+        auto& subscriber = components[i]->subscriber;
+        REQUIRE(waitUntil([&subscriber]() { return subscriber.calledTimes == PUBLISHERS * EVENTS_SENT; }));
+        REQUIRE(subscriber.isSerial);
+        runOn(*strands[i], [&component = components[i]]() { component.reset(); });
+    }
+};
+
+TEST_CASE("Notifiers of the same strand exchange events", "[executor]")
+{
+    easy::Executor executor(2);
+    easy::Strand strand(executor);
+
+    auto pingNotifier = std::unique_ptr<easy::Notifier>{};
+    auto pongNotifier = std::unique_ptr<easy::Notifier>{};
+    auto subscriber = std::unique_ptr<PingPongSubscriber>{};
+    auto pongSubscriber = std::unique_ptr<PingPongSubscriber>{};
+    runOn(strand, [&]() {
+        pingNotifier = std::make_unique<easy::Notifier>(strand);
+        pongNotifier = std::make_unique<easy::Notifier>(strand);
+        subscriber = std::make_unique<PingPongSubscriber>(*pingNotifier);
+        pongSubscriber = std::make_unique<PingPongSubscriber>(*pongNotifier);
+    });
+
+    easy::Notifier notifier;
+    notifier.publish(PingEvent());
+
+    REQUIRE(waitUntil([&]() { return subscriber->pongs == 1u && pongSubscriber->pongs == 1u; }));
+    runOn(strand, [&]() {
+        REQUIRE_THROWS_AS(pingNotifier->waitAndDispatch(), std::logic_error);
+        subscriber.reset();
+        pongSubscriber.reset();
+        pingNotifier.reset();
+        pongNotifier.reset();
+    });
+};
+
+TEST_CASE("Notifier bound to strand publishes delayed and periodic events", "[executor][timer]")
+{
+    easy::Executor executor(1);
+    easy::Strand strand(executor);
+
+    auto component = std::unique_ptr<Component>{};
+    auto publisher = std::unique_ptr<easy::Notifier>{};
+    const auto start = std::chrono::steady_clock::now();
+    runOn(strand, [&]() {
+        component = std::make_unique<Component>(strand);
+        publisher = std::make_unique<easy::Notifier>(strand);
+        publisher->publishAfter(std::chrono::milliseconds(30), PingEvent());
+    });
+    auto& subscriber = component->subscriber;
+    REQUIRE(waitUntil([&subscriber]() { return subscriber.calledTimes == 1u; }));
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+
+    auto timer = easy::TimerHandle{};
+    runOn(strand, [&]() { timer = publisher->publishEvery(std::chrono::milliseconds(5), []() { return PingEvent(); }); });
+    REQUIRE(waitUntil([&subscriber]() { return subscriber.calledTimes >= 4u; }));
+
+    runOn(strand, [&]() { REQUIRE(publisher->cancel(timer)); });
+    runOn(strand, []() {});
+    const auto calledTimes = subscriber.calledTimes.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    REQUIRE(subscriber.calledTimes == calledTimes);
+    runOn(strand, [&]() {
+        publisher.reset();
+        component.reset();
+    });
+};
+
+TEST_CASE("Executor strands benchmark", "[executor][multiple_threads][benchmark]")
+{
+    auto benchmarkStrands = [](Catch::Benchmark::Chronometer& meter, std::size_t strandsCount) {
+        easy::Executor executor;
+        auto strands = std::vector<std::unique_ptr<easy::Strand>>{};
+        auto components = std::vector<std::unique_ptr<Component>>(strandsCount);
+        for (auto i = 0u; i < strandsCount; ++i)
+        {
+            auto& strand = *strands.emplace_back(std::make_unique<easy::Strand>(executor));
+            runOn(strand, [&component = components[i], &strand]() { component = std::make_unique<Component>(strand); });
+        }
+
+        easy::Notifier notifier;
+        auto sentEvents = 0u;
+        meter.measure([&]() {
+            notifier.publish(PingEvent());
+            ++sentEvents;
+            for (const auto& component : components)
+            {
+                while (component->subscriber.calledTimes != sentEvents)
+                    std::this_thread::yield();
+            }
+        });
+
+        for (auto i = 0u; i < strandsCount; ++i)
+            runOn(*strands[i], [&component = components[i]]() { component.reset(); });
+    };
+
+    BENCHMARK_ADVANCED("10 Strands")(Catch::Benchmark::Chronometer meter) {
+        benchmarkStrands(meter, 10);
+    };
+
+    BENCHMARK_ADVANCED("1000 Strands")(Catch::Benchmark::Chronometer meter) {
+        benchmarkStrands(meter, 1000);
+    };
+};
+
+}  // namespace executor
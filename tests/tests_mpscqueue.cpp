@@ -0,0 +1,65 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/mpscqueue.hpp"
+
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Queue is empty on initialization", "[mpsc_queue]")
+{
+    auto queue = easy::MpscQueue<int>{};
+    REQUIRE(queue.empty());
+    REQUIRE(queue.consume([](int) { REQUIRE(false); }) == 0u);
+};
+
+TEST_CASE("Queue consumes elements in push order", "[mpsc_queue]")
+{
+    auto queue = easy::MpscQueue<int>{};
+    auto expected = std::vector{5, 11, 14, 14, 5, 1, INT_MAX, INT_MIN};
+
+    for (const auto& value : expected)
+    {
+        queue.push(value);
+    }
+    REQUIRE_FALSE(queue.empty());
+
+    auto consumed = std::vector<int>{};
+    REQUIRE(queue.consume([&consumed](int value) { consumed.push_back(value); }) == expected.size());
+    REQUIRE(consumed == expected);
+    REQUIRE(queue.empty());
+};
+
+TEST_CASE("Queue keeps order of each producer", "[mpsc_queue][multiple_threads]")
+{
+    const auto PRODUCERS = 4;
+    const auto VALUES_PER_PRODUCER = 10000;
+
+    auto queue = easy::MpscQueue<std::pair<int, int>>{};
+    auto producers = std::vector<std::thread>{};
+    for (auto producer = 0; producer < PRODUCERS; ++producer)
+    {
+        producers.emplace_back([&queue, producer]() {
+            for (auto value = 0; value < VALUES_PER_PRODUCER; ++value)
+            {
+                queue.push({producer, value});
+            }
+        });
+    }
+
+    auto lastValues = std::vector<int>(PRODUCERS, -1);
+    auto consumed = 0u;
+    auto consumeInOrder = [&lastValues](std::pair<int, int> item) {
+        REQUIRE(item.second == lastValues[item.first] + 1);
+        lastValues[item.first] = item.second;
+    };
+    while (consumed < PRODUCERS * VALUES_PER_PRODUCER)
+    {
+        consumed += queue.consume(consumeInOrder);
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    REQUIRE(queue.empty());
+};
@@ -2,7 +2,12 @@
 #include "easy/subscriber.hpp"
 #include "easy/notifier.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <variant>
+#include <vector>
 
 
 namespace multi_thread
@@ -60,6 +65,39 @@ public:
     std::thread::id threadId;
 };
 
+class FrameEvent : public easy::Event<FrameEvent>
+{
+public:
+    FrameEvent(std::size_t size) : buffer{std::make_unique<std::vector<char>>(size)} {}
+
+public:
+    std::unique_ptr<std::vector<char>> buffer;
+};
+
+class SensorReadEvent : public easy::Event<SensorReadEvent>
+{
+public:
+    static constexpr bool CONFLATING = true;
+
+    SensorReadEvent(int value) : value{value} {}
+
+public:
+    int value = {};
+};
+
+class ControlEvent : public easy::Event<ControlEvent, easy::Priority::High> {};
+class SampleEvent : public easy::Event<SampleEvent, easy::Priority::Low> {};
+
+class DeviceEvent : public easy::Event<DeviceEvent>
+{
+public:
+    DeviceEvent(unsigned device) : device{device} {}
+    Key_t topic() const override { return device; }
+
+public:
+    unsigned device = {};
+};
+
 template <typename T>
 class Subscriber : public easy::Subscribe<T>
 {
@@ -354,6 +392,574 @@ TEST_CASE("Subscribers under different notifiers receives only subscribed events
 };
 
 
+TEST_CASE("Thread reusing context of finished thread does not receive its events", "[multiple_threads][multiple_notifiers]")
+{
+    easy::Notifier notifier;
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+
+    auto t1 = std::thread([&isSubscribed, &isPublished]() {
+        easy::Notifier notifier;
+        auto sub = Subscriber<EventThread>(notifier, 0);
+        isSubscribed = true;
+        while (!isPublished)
+            std::this_thread::yield();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+    notifier.publish(EventThread());
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+
+    auto t2 = std::thread([]() {
+        easy::Notifier notifier;
+        auto sub = Subscriber<EventThread>(notifier, 0);
+        REQUIRE_FALSE(notifier.dispatch());
+    });
+
+    if (t2.joinable())
+        t2.join();
+
+    REQUIRE_FALSE(notifier.dispatch());
+};
+
+
+TEST_CASE("Batch of events is received in publish order from different thread", "[multiple_threads][single_notifier][batch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    easy::Notifier notifier;
+    std::atomic_bool isSubscribed = false;
+
+    auto t1 = std::thread([&isSubscribed]() {
+        const auto EVENTS_IN_BATCH = 4u;
+        const auto timeout = 200ms;
+        easy::Notifier notifier;
+        auto sub = DoubleSubscriber<EventThread, EventThread2>(notifier, 2);
+        auto sub2 = Subscriber<EventThread2>(notifier, 2);
+        isSubscribed = true;
+
+        auto dispatchTimes = 0u;
+        auto start = std::chrono::high_resolution_clock::now();
+        while (dispatchTimes != EVENTS_IN_BATCH)
+        {
+            dispatchTimes += notifier.dispatch();
+            if (std::chrono::high_resolution_clock::now() - start >= timeout)
+            {
+                return;
+            }
+        }
+        REQUIRE_FALSE(notifier.dispatch());
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+    notifier.publishBatch(std::vector<std::variant<EventThread, EventThread2, EventThread3>>{
+        EventThread(), EventThread2(), EventThread3(), EventThread(), EventThread2()
+    });
+
+    if (t1.joinable())
+        t1.join();
+};
+
+
+TEST_CASE("Dispatch all delivers events received from different thread", "[multiple_threads][single_notifier][dispatch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    const auto EVENTS_SENT = 10u;
+    easy::Notifier notifier;
+    std::atomic_bool isSubscribed = false;
+
+    auto t1 = std::thread([&isSubscribed]() {
+        const auto timeout = 200ms;
+        easy::Notifier notifier;
+        auto sub = Subscriber<EventThread>(notifier, EVENTS_SENT);
+        isSubscribed = true;
+
+        auto dispatchTimes = 0u;
+        auto start = std::chrono::high_resolution_clock::now();
+        while (dispatchTimes != EVENTS_SENT)
+        {
+            dispatchTimes += notifier.dispatchAll();
+            if (std::chrono::high_resolution_clock::now() - start >= timeout)
+            {
+                return;
+            }
+        }
+        REQUIRE(notifier.dispatchAll() == 0u);
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+    for (auto i = 0u; i < EVENTS_SENT; ++i)
+        notifier.publish(EventThread());
+
+    if (t1.joinable())
+        t1.join();
+};
+
+
+TEST_CASE("Waiting subscriber is woken up by event from different thread", "[multiple_threads][single_notifier][dispatch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    easy::Notifier notifier;
+    std::atomic_bool isSubscribed = false;
+
+    auto t1 = std::thread([&isSubscribed]() {
+        easy::Notifier notifier;
+        auto sub = Subscriber<EventThread>(notifier);
+        isSubscribed = true;
+        REQUIRE(notifier.waitAndDispatch() == 1u);
+        REQUIRE(notifier.dispatchWait(1ms) == 0u);
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(10ms);  // let the second thread block on waiting for events
+    notifier.publish(EventThread2());
+    notifier.publish(EventThread());
+
+    if (t1.joinable())
+        t1.join();
+};
+
+TEST_CASE("Move-only event is passed to different thread without copy", "[multiple_threads][single_notifier]")
+{
+    class FrameSubscriber : public easy::Subscribe<FrameEvent>
+    {
+    public:
+        FrameSubscriber(easy::Notifier& notifier) : easy::Subscribe<FrameEvent>{notifier} {}
+        void onEvent(const FrameEvent&) { isCopyNeeded = true; }
+        void onEvent(FrameEvent&& event) { buffer = std::move(event.buffer); }
+
+    public:
+        bool isCopyNeeded = false;
+        std::unique_ptr<std::vector<char>> buffer;
+    };
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic<const std::vector<char>*> sentBuffer = nullptr;
+
+    auto t1 = std::thread([&isSubscribed, &sentBuffer]() {
+        easy::Notifier notifier;
+        auto sub = FrameSubscriber(notifier);
+        isSubscribed = true;
+
+        REQUIRE(notifier.waitAndDispatch() == 1u);
+        REQUIRE_FALSE(sub.isCopyNeeded);
+        REQUIRE(sub.buffer.get() == sentBuffer);
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto frame = FrameEvent(4 * 1024 * 1024);
+    sentBuffer = frame.buffer.get();
+    notifier.publish(std::move(frame));
+
+    if (t1.joinable())
+        t1.join();
+};
+
+TEST_CASE("Slow consumer receives only the latest conflating event", "[multiple_threads][single_notifier][conflation]")
+{
+    class SensorReadSubscriber : public easy::Subscribe<SensorReadEvent>
+    {
+    public:
+        SensorReadSubscriber(easy::Notifier& notifier) : easy::Subscribe<SensorReadEvent>{notifier} {}
+        void onEvent(const SensorReadEvent& event) { values.push_back(event.value); }
+
+    public:
+        std::vector<int> values;
+    };
+
+    const auto EVENTS_SENT = 1000;
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        auto sub = SensorReadSubscriber(notifier);
+        isSubscribed = true;
+
+        while (!isPublished)
+            std::this_thread::yield();
+
+        REQUIRE(notifier.dispatchAll() == 1u);
+        REQUIRE(sub.values == std::vector{EVENTS_SENT});
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    for (auto i = 1; i <= EVENTS_SENT; ++i)
+        notifier.publish(SensorReadEvent(i));
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+};
+
+TEST_CASE("Events rejected by filter are not sent to different thread", "[multiple_threads][single_notifier][filter]")
+{
+    class SensorReadSubscriber : public easy::Subscribe<SensorReadEvent>
+    {
+    public:
+        SensorReadSubscriber(easy::Notifier& notifier)
+            : easy::Subscribe<SensorReadEvent>{notifier, [](const SensorReadEvent& event) { return event.value >= 512; }}
+        {}
+        void onEvent(const SensorReadEvent& event) { values.push_back(event.value); }
+
+    public:
+        std::vector<int> values;
+    };
+
+    const auto EVENTS_SENT = 1024;
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto dispatched = std::size_t{};
+    auto droppedEvents = std::size_t{};
+    auto values = std::vector<int>{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{EVENTS_SENT / 2, easy::OverflowPolicy::Fail});
+        auto sub = SensorReadSubscriber(notifier);
+        isSubscribed = true;
+
+        while (!isPublished)
+            std::this_thread::yield();
+
+        dispatched = notifier.dispatchAll();
+        values = sub.values;
+        droppedEvents = notifier.droppedThreadEvents();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto isPublishedAll = true;
+    for (auto i = 0; i < EVENTS_SENT; ++i)
+        isPublishedAll = notifier.publish(SensorReadEvent(i)) == easy::PublishStatus::Ok && isPublishedAll;
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(isPublishedAll);
+    REQUIRE(dispatched == 1u);    // conflated
+    REQUIRE(values == std::vector{EVENTS_SENT - 1});
+    REQUIRE(droppedEvents == 0u);
+};
+
+TEST_CASE("Conflating events are conflated in inbox of busy thread", "[multiple_threads][single_notifier][conflation]")
+{
+    class SensorReadSubscriber : public easy::Subscribe<SensorReadEvent>
+    {
+    public:
+        SensorReadSubscriber(easy::Notifier& notifier) : easy::Subscribe<SensorReadEvent>{notifier} {}
+        void onEvent(const SensorReadEvent& event) { values.push_back(event.value); }
+
+    public:
+        std::vector<int> values;
+    };
+
+    const auto EVENTS_SENT = 1000;
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto queuedEvents = std::size_t{};
+    auto dispatched = std::size_t{};
+    auto values = std::vector<int>{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{1, easy::OverflowPolicy::Fail});
+        auto sub = SensorReadSubscriber(notifier);
+        isSubscribed = true;
+
+        while (!isPublished)
+            std::this_thread::yield();
+
+        queuedEvents = notifier.queuedThreadEvents();
+        dispatched = notifier.dispatchAll();
+        values = sub.values;
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto statuses = std::vector<easy::PublishStatus>{};
+    for (auto i = 0; i < EVENTS_SENT; ++i)
+        statuses.push_back(notifier.publish(SensorReadEvent(i)));
+    notifier.publishBatch(std::vector{SensorReadEvent(EVENTS_SENT), SensorReadEvent(EVENTS_SENT + 1)});
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(std::ranges::all_of(statuses, [](auto status) { return status == easy::PublishStatus::Ok; }));
+    REQUIRE(queuedEvents == 1u);
+    REQUIRE(dispatched == 1u);
+    REQUIRE(values == std::vector{EVENTS_SENT + 1});
+};
+
+TEST_CASE("Events of other topics are not sent to different thread", "[multiple_threads][single_notifier][topic]")
+{
+    class DeviceSubscriber : public easy::Subscribe<easy::Topic<DeviceEvent>>
+    {
+    public:
+        DeviceSubscriber(easy::Notifier& notifier, unsigned device)
+            : easy::Subscribe<easy::Topic<DeviceEvent>>{notifier}
+        {
+            subscribeTopic<DeviceEvent>(device);
+        }
+        void onEvent(const DeviceEvent& event) { devices.push_back(event.device); }
+
+    public:
+        std::vector<unsigned> devices;
+    };
+
+    const auto DEVICES = 100u;
+    const auto ROUNDS = 10u;
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto dispatched = std::size_t{};
+    auto devices = std::vector<unsigned>{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{ROUNDS, easy::OverflowPolicy::Fail});
+        auto sub = DeviceSubscriber(notifier, 7);
+        isSubscribed = true;
+
+        while (!isPublished)
+            std::this_thread::yield();
+
+        dispatched = notifier.dispatchAll();
+        devices = sub.devices;
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto isPublishedAll = true;
+    for (auto round = 0u; round < ROUNDS; ++round)
+    {
+        for (auto device = 0u; device < DEVICES; ++device)
+            isPublishedAll = notifier.publish(DeviceEvent(device)) == easy::PublishStatus::Ok && isPublishedAll;
+    }
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(isPublishedAll);
+    REQUIRE(dispatched == ROUNDS);
+    REQUIRE(devices == std::vector<unsigned>(ROUNDS, 7));
+};
+
+TEST_CASE("Dispatch with wait times out when no event arrives", "[multiple_threads][single_notifier][dispatch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    easy::Notifier notifier;
+    auto sub = Subscriber<EventThread>(notifier, 0);
+
+    const auto timeout = 20ms;
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(notifier.dispatchWait(timeout) == 0u);
+    REQUIRE(std::chrono::steady_clock::now() - start >= timeout);
+};
+
+
+TEST_CASE("Thread queue limit drops events according to policy", "[multiple_threads][single_notifier][queue_limit]")
+{
+    struct Parameters
+    {
+        easy::OverflowPolicy policy;
+        easy::PublishStatus overflowStatus;
+    };
+
+    const auto CAPACITY = 2u;
+    const auto EVENTS_SENT = 5u;
+
+    auto params = std::vector{
+        Parameters{easy::OverflowPolicy::DropNewest, easy::PublishStatus::Ok},
+        Parameters{easy::OverflowPolicy::DropOldest, easy::PublishStatus::Ok},
+        Parameters{easy::OverflowPolicy::Fail, easy::PublishStatus::QueueFull}
+    };
+
+    for (const auto& param : params)
+    {
+        easy::Notifier notifier;
+        std::atomic_bool isSubscribed = false;
+        std::atomic_bool isPublished = false;
+        auto dispatched = std::size_t{};
+        auto droppedEvents = std::size_t{};
+
+        auto t1 = std::thread([&, policy = param.policy]() {
+            easy::Notifier notifier;
+            notifier.setThreadQueueLimit(easy::QueueLimit{CAPACITY, policy});
+            auto sub = Subscriber<EventThread>(notifier, CAPACITY, 0, false);
+            isSubscribed = true;
+            while (!isPublished)
+                std::this_thread::yield();
+
+            dispatched = notifier.dispatchAll();
+            droppedEvents = notifier.droppedThreadEvents();
+        });
+
+        while (!isSubscribed)
+            std::this_thread::yield();
+        auto statuses = std::vector<easy::PublishStatus>{};
+        for (auto i = 0u; i < EVENTS_SENT; ++i)
+            statuses.push_back(notifier.publish(EventThread()));
+        isPublished = true;
+
+        if (t1.joinable())
+            t1.join();
+        for (auto i = 0u; i < EVENTS_SENT; ++i)
+            REQUIRE(statuses[i] == (i < CAPACITY ? easy::PublishStatus::Ok : param.overflowStatus));
+        REQUIRE(dispatched == CAPACITY);
+        REQUIRE(droppedEvents == EVENTS_SENT - CAPACITY);
+    }
+};
+
+TEST_CASE("Thread queue limit blocks publisher until consumer makes room", "[multiple_threads][single_notifier][queue_limit]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    const auto CAPACITY = 1u;
+    const auto EVENTS_SENT = 3u;
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto isPublishedEarly = true;
+    auto droppedEvents = std::size_t{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{CAPACITY, easy::OverflowPolicy::Block});
+        auto sub = Subscriber<EventThread>(notifier, EVENTS_SENT, 0, false);
+        isSubscribed = true;
+
+        std::this_thread::sleep_for(20ms);
+        isPublishedEarly = isPublished;
+
+        auto dispatchTimes = 0u;
+        while (dispatchTimes != EVENTS_SENT)
+            dispatchTimes += notifier.waitAndDispatch();
+        droppedEvents = notifier.droppedThreadEvents();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto isPublishedAll = true;
+    for (auto i = 0u; i < EVENTS_SENT; ++i)
+        isPublishedAll = notifier.publish(EventThread()) == easy::PublishStatus::Ok && isPublishedAll;
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(isPublishedAll);
+    REQUIRE_FALSE(isPublishedEarly);
+    REQUIRE(droppedEvents == 0u);
+};
+
+
+TEST_CASE("Thread queue limit evicts the oldest events while consumer is slow", "[multiple_threads][single_notifier][queue_limit]")
+{
+    const auto CAPACITY = 2u;
+    const auto EVENTS_SENT = 1000u;
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto droppedEvents = std::size_t{};
+    auto dispatched = std::size_t{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{CAPACITY, easy::OverflowPolicy::DropOldest});
+        auto sub = Subscriber<EventThread>(notifier, CAPACITY, 0, false);
+        isSubscribed = true;
+        while (!isPublished)
+            std::this_thread::yield();
+
+        droppedEvents = notifier.droppedThreadEvents();    // evicted before dispatch
+        dispatched = notifier.dispatchAll();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto isPublishedAll = true;
+    for (auto i = 0u; i < EVENTS_SENT; ++i)
+        isPublishedAll = notifier.publish(EventThread()) == easy::PublishStatus::Ok && isPublishedAll;
+    notifier.publishBatch(std::vector<EventThread>(EVENTS_SENT));
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(isPublishedAll);
+    REQUIRE(droppedEvents == 2 * EVENTS_SENT - CAPACITY);
+    REQUIRE(dispatched == CAPACITY);
+};
+
+TEST_CASE("Thread queue limit blocks batch publisher at capacity", "[multiple_threads][single_notifier][queue_limit][batch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    const auto CAPACITY = 2u;
+    const auto EVENTS_SENT = 10u;
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isPublished = false;
+    auto isPublishedEarly = true;
+    auto firstDispatched = std::size_t{};
+    auto droppedEvents = std::size_t{};
+
+    auto t1 = std::thread([&]() {
+        easy::Notifier notifier;
+        notifier.setThreadQueueLimit(easy::QueueLimit{CAPACITY, easy::OverflowPolicy::Block});
+        auto sub = Subscriber<EventThread>(notifier, EVENTS_SENT, 0, false);
+        isSubscribed = true;
+
+        std::this_thread::sleep_for(20ms);
+        isPublishedEarly = isPublished;
+
+        firstDispatched = notifier.dispatchAll();
+        auto dispatchTimes = firstDispatched;
+        while (dispatchTimes != EVENTS_SENT)
+            dispatchTimes += notifier.waitAndDispatch();
+        droppedEvents = notifier.droppedThreadEvents();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    const auto status = notifier.publishBatch(std::vector<EventThread>(EVENTS_SENT));
+    isPublished = true;
+
+    if (t1.joinable())
+        t1.join();
+    REQUIRE(status == easy::PublishStatus::Ok);
+    REQUIRE_FALSE(isPublishedEarly);
+    REQUIRE(firstDispatched <= CAPACITY + 1);    // the publisher may admit one event before it waits
+    REQUIRE(droppedEvents == 0u);
+};
+
+
 TEST_CASE("Multithread communication benchmark", "[multiple_threads][multiple_notifiers][benchmark]")
 {
     using std::literals::chrono_literals::operator""ms;
@@ -493,4 +1099,182 @@ TEST_CASE("Multithread communication benchmark", "[multiple_threads][multiple_no
 
 }
 
+TEST_CASE("Multithread publish throughput benchmark", "[multiple_threads][multiple_notifiers][benchmark]")
+{
+    const auto EVENTS_PER_PRODUCER = 1000u;
+
+    auto publishFromProducers = [](Catch::Benchmark::Chronometer& meter, unsigned producersCount) {
+        std::atomic_uint readyThreads = 0;
+        std::atomic_uint round = 0;
+        std::atomic_uint received = 0;
+        std::atomic_bool isWorking = true;
+
+        auto consumer = std::thread([&]() {
+            easy::Notifier notifier;
+            auto sub = Subscriber<EventThread>(notifier, 0, 0, false);
+            ++readyThreads;
+            while (isWorking)
+                received += static_cast<unsigned>(notifier.dispatchAll());
+        });
+
+        auto producers = std::vector<std::thread>{};
+        for (auto i = 0u; i < producersCount; ++i)
+        {
+            producers.emplace_back([&]() {
+                easy::Notifier notifier;
+                ++readyThreads;
+                auto lastRound = 0u;
+                while (true)
+                {
+                    while (round == lastRound && isWorking)
+                        std::this_thread::yield();
+                    if (!isWorking)
+                        break;
+
+                    lastRound = round;
+                    for (auto event = 0u; event < EVENTS_PER_PRODUCER; ++event)
+                        notifier.publish(EventThread());
+                }
+            });
+        }
+
+        while (readyThreads != producersCount + 1)
+            std::this_thread::yield();
+
+        meter.measure([&] {    // threads and notifiers are created once, only publish and drain are measured
+            const auto expected = received + producersCount * EVENTS_PER_PRODUCER;
+            ++round;
+            while (received != expected)
+                std::this_thread::yield();
+        });
+
+        isWorking = false;
+        for (auto& producer : producers)
+            producer.join();
+        if (consumer.joinable())
+            consumer.join();
+    };
+
+    BENCHMARK_ADVANCED("1 Producer | 1 Consumer | 1000 messages per producer")(Catch::Benchmark::Chronometer meter) {
+        publishFromProducers(meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("2 Producers | 1 Consumer | 1000 messages per producer")(Catch::Benchmark::Chronometer meter) {
+        publishFromProducers(meter, 2);
+    };
+
+    BENCHMARK_ADVANCED("4 Producers | 1 Consumer | 1000 messages per producer")(Catch::Benchmark::Chronometer meter) {
+        publishFromProducers(meter, 4);
+    };
+
+    BENCHMARK_ADVANCED("8 Producers | 1 Consumer | 1000 messages per producer")(Catch::Benchmark::Chronometer meter) {
+        publishFromProducers(meter, 8);
+    };
+}
+
+
+TEST_CASE("Batch publish benchmark", "[multiple_threads][multiple_notifiers][batch][benchmark]")
+{
+    const auto EVENTS_IN_BURST = 100u;
+
+    std::atomic_bool isConsumerReady = false;
+    std::atomic_bool isWorking = true;
+
+    auto consumer = std::thread([&isConsumerReady, &isWorking]() {
+        easy::Notifier notifier;
+        auto sub = Subscriber<EventThread>(notifier, 0, 0, false);
+        isConsumerReady = true;
+        while (isWorking)
+            notifier.dispatch();
+    });
+
+    while (!isConsumerReady)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+
+    BENCHMARK("Publish 100 events one by one")
+    {
+        for (auto i = 0u; i < EVENTS_IN_BURST; ++i)
+            notifier.publish(EventThread());
+    };
+
+    BENCHMARK("Publish 100 events in batch")
+    {
+        notifier.publishBatch(std::vector<EventThread>(EVENTS_IN_BURST));
+    };
+
+    isWorking = false;
+    if (consumer.joinable())
+        consumer.join();
+}
+
+TEST_CASE("Thread queue limit does not drop or block high priority events", "[multiple_threads][single_notifier][queue_limit]")
+{
+    class ControlSubscriber : public easy::Subscribe<ControlEvent, SampleEvent>
+    {
+    public:
+        ControlSubscriber(easy::Notifier& notifier) : easy::Subscribe<ControlEvent, SampleEvent>{notifier} {}
+        void onEvent(const ControlEvent&) { ++controls; }
+        void onEvent(const SampleEvent&) { ++samples; }
+
+    public:
+        unsigned controls = 0;
+        unsigned samples = 0;
+    };
+
+    struct Parameters
+    {
+        easy::OverflowPolicy policy;
+        unsigned samplesSent;
+        unsigned samplesReceived;
+    };
+
+    const auto CAPACITY = 2u;
+    const auto SAMPLES_SENT = 100u;
+
+    auto params = std::vector{
+        Parameters{easy::OverflowPolicy::DropNewest, SAMPLES_SENT, CAPACITY},
+        Parameters{easy::OverflowPolicy::DropOldest, SAMPLES_SENT, CAPACITY - 1},    // evicted by control event
+        Parameters{easy::OverflowPolicy::Fail, SAMPLES_SENT, CAPACITY},
+        Parameters{easy::OverflowPolicy::Block, CAPACITY, CAPACITY}
+    };
+
+    for (const auto& param : params)
+    {
+        std::atomic_bool isSubscribed = false;
+        std::atomic_bool isPublished = false;
+        auto controls = 0u;
+        auto samples = 0u;
+
+        auto t1 = std::thread([&, policy = param.policy]() {
+            easy::Notifier notifier;
+            notifier.setThreadQueueLimit(easy::QueueLimit{CAPACITY, policy});
+            auto sub = ControlSubscriber(notifier);
+            isSubscribed = true;
+            while (!isPublished)
+                std::this_thread::yield();
+
+            notifier.dispatchAll();
+            controls = sub.controls;
+            samples = sub.samples;
+        });
+
+        while (!isSubscribed)
+            std::this_thread::yield();
+
+        easy::Notifier notifier;
+        for (auto i = 0u; i < param.samplesSent; ++i)
+            notifier.publish(SampleEvent());
+        const auto controlStatus = notifier.publish(ControlEvent());    // inbox is full, consumer does not dispatch
+        isPublished = true;
+
+        if (t1.joinable())
+            t1.join();
+        REQUIRE(controlStatus == easy::PublishStatus::Ok);
+        REQUIRE(controls == 1u);
+        REQUIRE(samples == param.samplesReceived);
+    }
+};
+
 }  // namespace multi_thread
@@ -0,0 +1,364 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/poolallocator.hpp"
+#include "easy/subscriber.hpp"
+#include "easy/notifier.hpp"
+#include "easy/task.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+thread_local bool isAllocationCounted = false;
+thread_local std::size_t allocationsCount = 0;
+
+class AllocationCounter
+{
+public:
+    AllocationCounter() { allocationsCount = 0; isAllocationCounted = true; }
+    ~AllocationCounter() { isAllocationCounted = false; }
+    std::size_t allocations() const { return allocationsCount; }
+};
+
+}  // namespace
+
+
+void* operator new(std::size_t size)
+{
+    if (isAllocationCounted)
+        ++allocationsCount;
+    if (auto pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)    // used by pool for its slabs
+{
+    if (isAllocationCounted)
+        ++allocationsCount;
+    const auto align = static_cast<std::size_t>(alignment);
+    if (auto pointer = std::aligned_alloc(align, (std::max(size, std::size_t{1}) + align - 1) / align * align))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+namespace pool_allocator
+{
+
+class SensorReadEvent : public easy::Event<SensorReadEvent>
+{
+public:
+    SensorReadEvent(int data) : data{data} {}
+
+public:
+    int data = {};
+};
+
+class SensorSamplesEvent : public easy::Event<SensorSamplesEvent>
+{
+public:
+    SensorSamplesEvent(int data) { samples.fill(data); }
+
+public:
+    std::array<int, 16> samples = {};
+};
+
+static_assert(easy::EventStorage::isStoredInline<SensorReadEvent>);
+static_assert(!easy::EventStorage::isStoredInline<SensorSamplesEvent>);
+
+class SensorReadSubscriber : public easy::Subscribe<SensorReadEvent>
+{
+public:
+    SensorReadSubscriber(easy::Notifier& notifier) : easy::Subscribe<SensorReadEvent>{notifier} {}
+    void onEvent(const SensorReadEvent& event) { sum += event.data; ++calledTimes; }
+
+public:
+    long long sum = 0;
+    std::atomic_uint calledTimes = 0;
+};
+
+class SensorSamplesSubscriber : public easy::Subscribe<SensorSamplesEvent>
+{
+public:
+    SensorSamplesSubscriber(easy::Notifier& notifier) : easy::Subscribe<SensorSamplesEvent>{notifier} {}
+    void onEvent(const SensorSamplesEvent& event) { sum += event.samples.back(); ++calledTimes; }
+
+public:
+    long long sum = 0;
+    std::atomic_uint calledTimes = 0;
+};
+
+
+TEST_CASE("Pool reuses released blocks", "[pool_allocator]")
+{
+    using Pool = easy::MemoryPool<sizeof(SensorReadEvent), alignof(SensorReadEvent)>;
+
+    auto blocks = std::vector<void*>{};
+    for (auto i = 0; i < 10; ++i)
+        blocks.push_back(Pool::allocate());
+
+    REQUIRE(std::unique(blocks.begin(), blocks.end()) == blocks.end());
+    for (auto block : blocks)
+        REQUIRE(reinterpret_cast<std::uintptr_t>(block) % alignof(SensorReadEvent) == 0);
+
+    auto released = blocks.back();
+    Pool::deallocate(released);
+    blocks.pop_back();
+    REQUIRE(Pool::allocate() == released);
+    blocks.push_back(released);
+
+    for (auto block : blocks)
+        Pool::deallocate(block);
+};
+
+TEST_CASE("Allocation counter counts slabs of the pool", "[pool_allocator]")
+{
+    using Pool = easy::MemoryPool<4000, 64>;    // not used elsewhere, so its free lists are empty
+    const auto SLAB_BLOCKS = std::size_t{64};
+
+    auto blocks = std::vector<void*>{Pool::allocate()};    // creates the pool with its first slab
+    blocks.reserve(SLAB_BLOCKS + 1);
+
+    auto allocations = std::size_t{};
+    {
+        auto counter = AllocationCounter{};
+        while (blocks.size() <= SLAB_BLOCKS)    // the last one comes from a new slab
+            blocks.push_back(Pool::allocate());
+        allocations = counter.allocations();
+    }
+
+    REQUIRE(allocations == 1u);
+    for (auto block : blocks)
+        Pool::deallocate(block);
+};
+
+TEST_CASE("Publishing in single thread does not allocate in steady state", "[pool_allocator][single_thread]")
+{
+    const auto EVENTS_SENT = 1000;
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = SensorReadSubscriber(notifier);
+
+    auto publishAndDispatch = [&]() {
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+        {
+            notifierBase.publish(SensorReadEvent(i));
+            if (i % 10 == 0)
+                notifier.dispatchAll();
+        }
+        notifier.dispatchAll();
+    };
+
+    publishAndDispatch();    // warm up pools and queues
+
+    auto allocations = std::size_t{};
+    {
+        auto counter = AllocationCounter{};
+        publishAndDispatch();
+        allocations = counter.allocations();
+    }
+
+    REQUIRE(allocations == 0u);
+    REQUIRE(sub.calledTimes == 2u * EVENTS_SENT);
+};
+
+TEST_CASE("Publishing events shared from pool does not allocate in steady state", "[pool_allocator][single_thread]")
+{
+    const auto EVENTS_SENT = 1000;
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    easy::Notifier notifier2;
+    auto sub = SensorSamplesSubscriber(notifier);
+    auto sub2 = SensorSamplesSubscriber(notifier2);
+
+    auto publishAndDispatch = [&]() {
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+        {
+            notifierBase.publish(SensorSamplesEvent(i));
+            if (i % 10 == 0)
+            {
+                notifier.dispatchAll();
+                notifier2.dispatchAll();
+            }
+        }
+        notifier.dispatchAll();
+        notifier2.dispatchAll();
+    };
+
+    publishAndDispatch();    // warm up pools and queues
+
+    auto allocations = std::size_t{};
+    {
+        auto counter = AllocationCounter{};
+        publishAndDispatch();
+        allocations = counter.allocations();
+    }
+
+    REQUIRE(allocations == 0u);
+    REQUIRE(sub.calledTimes == 2u * EVENTS_SENT);
+    REQUIRE(sub2.sum == 2ll * EVENTS_SENT * (EVENTS_SENT - 1) / 2);
+};
+
+TEST_CASE("Awaiting events does not allocate in steady state", "[pool_allocator][single_thread][coroutines]")
+{
+    const auto EVENTS_SENT = 1000;
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto sum = 0ll;
+    auto task = [](easy::Notifier& notifier, long long& sum) -> easy::Task {
+        while (true)
+            sum += (co_await notifier.next<SensorReadEvent>()).data;
+    }(notifier, sum);
+
+    auto publishAndDispatch = [&]() {
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+        {
+            notifierBase.publish(SensorReadEvent(i));
+            notifier.dispatchAll();
+        }
+    };
+
+    publishAndDispatch();    // warm up pools and queues
+
+    auto allocations = std::size_t{};
+    {
+        auto counter = AllocationCounter{};
+        publishAndDispatch();
+        allocations = counter.allocations();
+    }
+
+    REQUIRE(allocations == 0u);
+    REQUIRE(sum == 2ll * EVENTS_SENT * (EVENTS_SENT - 1) / 2);
+};
+
+TEST_CASE("Publishing between threads does not allocate in steady state", "[pool_allocator][multiple_threads]")
+{
+    const auto ROUNDS = 200u;
+    const auto EVENTS_IN_ROUND = 50u;
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isCounting = false;
+    std::atomic_bool isWorking = true;
+    std::atomic_uint received = 0;
+    std::atomic<std::size_t> consumerAllocations = 0;
+
+    auto consumer = std::thread([&]() {
+        easy::Notifier notifier;
+        auto sub = SensorReadSubscriber(notifier);
+        auto samplesSub = SensorSamplesSubscriber(notifier);    // events shared from pool, not stored inline
+        isSubscribed = true;
+
+        auto counter = std::optional<AllocationCounter>{};
+        while (isWorking)
+        {
+            if (isCounting && !counter)
+                counter.emplace();
+            notifier.dispatchWait(std::chrono::milliseconds(1));
+            received = sub.calledTimes + samplesSub.calledTimes;
+        }
+        if (counter)
+            consumerAllocations = counter->allocations();
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto sentEvents = 0u;
+    auto publishRounds = [&]() {
+        for (auto round = 0u; round < ROUNDS; ++round)
+        {
+            for (auto i = 0u; i < EVENTS_IN_ROUND; ++i)
+            {
+                notifier.publish(SensorReadEvent(i));
+                notifier.publish(SensorSamplesEvent(i));
+            }
+            sentEvents += 2 * EVENTS_IN_ROUND;
+            while (received != sentEvents)
+                std::this_thread::yield();
+        }
+    };
+
+    publishRounds();    // warm up pools and queues
+
+    auto publisherAllocations = std::size_t{};
+    {
+        isCounting = true;
+        auto counter = AllocationCounter{};
+        publishRounds();
+        publisherAllocations = counter.allocations();
+    }
+
+    isWorking = false;
+    if (consumer.joinable())
+        consumer.join();
+
+    REQUIRE(publisherAllocations == 0u);
+    REQUIRE(consumerAllocations == 0u);
+};
+
+}  // namespace pool_allocator
@@ -0,0 +1,224 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/subscriber.hpp"
+#include "easy/notifier.hpp"
+#include "easy/task.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace request
+{
+
+class DemandSensorDataEvent : public easy::Event<DemandSensorDataEvent>
+{
+public:
+    DemandSensorDataEvent(unsigned sensor) : sensor{sensor} {}
+
+public:
+    unsigned sensor = {};
+};
+
+class SensorReadEvent : public easy::Event<SensorReadEvent>
+{
+public:
+    SensorReadEvent(int data) : data{data} {}
+
+public:
+    int data = {};
+};
+
+class SensorResponder : public easy::Subscribe<easy::Request<DemandSensorDataEvent>>
+{
+public:
+    SensorResponder(easy::Notifier& notifier) : easy::Subscribe<easy::Request<DemandSensorDataEvent>>{notifier} {}
+    void onEvent(const easy::Request<DemandSensorDataEvent>& request)
+    {
+        reply(request, SensorReadEvent(10 * request.event.sensor));
+    }
+};
+
+class DeferredResponder : public easy::Subscribe<easy::Request<DemandSensorDataEvent>>
+{
+public:
+    DeferredResponder(easy::Notifier& notifier) : easy::Subscribe<easy::Request<DemandSensorDataEvent>>{notifier} {}
+    void onEvent(const easy::Request<DemandSensorDataEvent>& request) { requests.push_back(request); }
+
+public:
+    std::vector<easy::Request<DemandSensorDataEvent>> requests;
+};
+
+class SensorReadSubscriber : public easy::Subscribe<DemandSensorDataEvent, SensorReadEvent>
+{
+public:
+    SensorReadSubscriber(easy::Notifier& notifier) : easy::Subscribe<DemandSensorDataEvent, SensorReadEvent>{notifier} {}
+    void onEvent(const DemandSensorDataEvent&) { ++calledTimes; }
+    void onEvent(const SensorReadEvent&) { ++calledTimes; }
+
+public:
+    unsigned calledTimes = 0;
+};
+
+
+easy::Task readSensor(easy::Notifier& notifier, unsigned sensor, std::optional<int>& result)
+{
+    auto reading = co_await notifier.request<SensorReadEvent>(DemandSensorDataEvent(sensor));
+    result = reading ? std::optional{reading->data} : std::nullopt;
+}
+
+easy::Task readSensorWithTimeout(easy::Notifier& notifier, unsigned sensor, std::optional<int>& result, bool& isDone)
+{
+    auto reading = co_await notifier.request<SensorReadEvent>(DemandSensorDataEvent(sensor),
+                                                              std::chrono::milliseconds(10));
+    result = reading ? std::optional{reading->data} : std::nullopt;
+    isDone = true;
+}
+
+
+TEST_CASE("Reply is received only by the requesting coroutine", "[single_thread][request]")
+{
+    easy::Notifier responderNotifier;
+    easy::Notifier notifier;
+    easy::Notifier notifier2;
+    easy::Notifier observerNotifier;
+    auto responder = SensorResponder(responderNotifier);
+    auto observer = SensorReadSubscriber(observerNotifier);
+
+    auto result = std::optional<int>{};
+    auto result2 = std::optional<int>{};
+    auto task = readSensor(notifier, 1, result);
+    auto task2 = readSensor(notifier2, 2, result2);
+
+    REQUIRE(responderNotifier.dispatchAll() == 2u);
+    REQUIRE(notifier2.dispatchAll() == 1u);
+    REQUIRE(result2 == 20);
+    REQUIRE_FALSE(result);
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(result == 10);
+    REQUIRE(task.isDone());
+    REQUIRE(task2.isDone());
+
+    REQUIRE(observerNotifier.dispatchAll() == 0u);
+    REQUIRE(observer.calledTimes == 0u);
+};
+
+TEST_CASE("Outstanding requests are matched with replies by correlation", "[single_thread][request]")
+{
+    const auto REQUESTS = 100u;
+
+    easy::Notifier responderNotifier;
+    easy::Notifier notifier;
+    auto responder = DeferredResponder(responderNotifier);
+
+    auto results = std::vector<std::optional<int>>(REQUESTS);
+    auto tasks = std::vector<easy::Task>{};
+    for (auto sensor = 0u; sensor < REQUESTS; ++sensor)
+        tasks.push_back(readSensor(notifier, sensor, results[sensor]));
+
+    REQUIRE(responderNotifier.dispatchAll() == REQUESTS);
+    for (auto request = responder.requests.rbegin(); request != responder.requests.rend(); ++request)
+        responderNotifier.reply(*request, SensorReadEvent(-static_cast<int>(request->event.sensor)));
+    responderNotifier.reply(responder.requests.front(), SensorReadEvent(1000));    // already answered
+
+    REQUIRE(notifier.dispatchAll() == REQUESTS + 1);
+    for (auto sensor = 0u; sensor < REQUESTS; ++sensor)
+        REQUIRE(results[sensor] == -static_cast<int>(sensor));
+};
+
+TEST_CASE("Request without reply times out", "[single_thread][request][timer]")
+{
+    easy::Notifier responderNotifier;
+    easy::Notifier notifier;
+    auto responder = DeferredResponder(responderNotifier);
+
+    auto result = std::optional<int>{1};
+    auto isDone = false;
+    auto task = readSensorWithTimeout(notifier, 1, result, isDone);
+    REQUIRE(responderNotifier.dispatchAll() == 1u);
+
+    REQUIRE(notifier.dispatchWait(std::chrono::milliseconds(50)) == 0u);
+    REQUIRE(isDone);
+    REQUIRE_FALSE(result);
+
+    responderNotifier.reply(responder.requests.front(), SensorReadEvent(10));    // too late
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE_FALSE(result);
+};
+
+TEST_CASE("Reply before timeout cancels the timeout", "[single_thread][request][timer]")
+{
+    easy::Notifier responderNotifier;
+    easy::Notifier notifier;
+    auto responder = SensorResponder(responderNotifier);
+
+    auto result = std::optional<int>{};
+    auto isDone = false;
+    auto task = readSensorWithTimeout(notifier, 3, result, isDone);
+    REQUIRE(responderNotifier.dispatchAll() == 1u);
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(isDone);
+    REQUIRE(result == 30);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(notifier.dispatchAll() == 0u);
+    REQUIRE(result == 30);
+};
+
+TEST_CASE("Request rejected by full queue completes without reply", "[single_thread][request]")
+{
+    easy::Notifier responderNotifier(easy::QueueLimit{1, easy::OverflowPolicy::Fail});
+    easy::Notifier notifier;
+    auto responder = SensorResponder(responderNotifier);
+
+    auto result = std::optional<int>{};
+    auto rejectedResult = std::optional<int>{1};
+    auto task = readSensor(notifier, 1, result);
+    auto rejectedTask = readSensor(notifier, 2, rejectedResult);
+    REQUIRE(rejectedTask.isDone());
+    REQUIRE_FALSE(rejectedResult);
+
+    REQUIRE(responderNotifier.dispatchAll() == 1u);
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(task.isDone());
+    REQUIRE(result == 10);
+};
+
+TEST_CASE("Requests are answered by responder in another thread", "[multiple_threads][request]")
+{
+    const auto REQUESTS = 1000u;
+
+    std::atomic_bool isSubscribed = false;
+    std::atomic_bool isWorking = true;
+    auto responderThread = std::thread([&]() {
+        easy::Notifier notifier;
+        auto responder = SensorResponder(notifier);
+        isSubscribed = true;
+        while (isWorking)
+            notifier.dispatchWait(std::chrono::milliseconds(1));
+    });
+
+    while (!isSubscribed)
+        std::this_thread::yield();
+
+    easy::Notifier notifier;
+    auto results = std::vector<std::optional<int>>(REQUESTS);
+    auto tasks = std::vector<easy::Task>{};
+    for (auto sensor = 0u; sensor < REQUESTS; ++sensor)
+        tasks.push_back(readSensor(notifier, sensor, results[sensor]));
+
+    auto replies = 0u;
+    while (replies < REQUESTS)
+        replies += notifier.dispatchWait(std::chrono::seconds(10));
+
+    isWorking = false;
+    if (responderThread.joinable())
+        responderThread.join();
+
+    for (auto sensor = 0u; sensor < REQUESTS; ++sensor)
+        REQUIRE(results[sensor] == 10 * static_cast<int>(sensor));
+};
+
+}  // namespace request
@@ -0,0 +1,50 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/ringbuffer.hpp"
+
+#include <memory>
+
+
+TEST_CASE("Ring buffer is empty on initialization", "[ring_buffer]")
+{
+    auto buffer = easy::RingBuffer<int>{};
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.size() == 0u);
+};
+
+TEST_CASE("Ring buffer keeps FIFO order while wrapping and growing", "[ring_buffer]")
+{
+    auto buffer = easy::RingBuffer<int>{};
+    auto nextPushed = 0;
+    auto nextPopped = 0;
+
+    for (auto round = 1; round <= 100; ++round)
+    {
+        for (auto i = 0; i < round % 7 + 3; ++i)
+            buffer.push(nextPushed++);
+
+        for (auto i = 0; i < round % 5 + 1 && !buffer.empty(); ++i)
+        {
+            REQUIRE(buffer.front() == nextPopped++);
+            buffer.pop();
+        }
+        REQUIRE(buffer.size() == static_cast<std::size_t>(nextPushed - nextPopped));
+    }
+
+    while (!buffer.empty())
+    {
+        REQUIRE(buffer.front() == nextPopped++);
+        buffer.pop();
+    }
+    REQUIRE(nextPopped == nextPushed);
+};
+
+TEST_CASE("Ring buffer releases popped elements", "[ring_buffer]")
+{
+    auto buffer = easy::RingBuffer<std::shared_ptr<int>>{};
+    auto value = std::make_shared<int>(5);
+
+    buffer.push(value);
+    REQUIRE(value.use_count() == 2);
+    buffer.pop();
+    REQUIRE(value.use_count() == 1);
+};
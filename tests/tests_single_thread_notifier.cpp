@@ -2,7 +2,13 @@
 #include "easy/subscriber.hpp"
 #include "easy/notifier.hpp"
 
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <variant>
+#include <vector>
 
 
 namespace single_thread
@@ -147,6 +153,177 @@ private:
     unsigned expectedCalledTimes = 0;
 };
 
+class OrderRecordingSubscriber : public easy::Subscribe<EventThread, EventThread2>
+{
+public:
+    OrderRecordingSubscriber(easy::Notifier& notifier)
+        : easy::Subscribe<EventThread, EventThread2>{notifier}
+    {}
+    void onEvent(const EventThread&) { receivedEvents.push_back(1); }
+    void onEvent(const EventThread2&) { receivedEvents.push_back(2); }
+
+public:
+    std::vector<int> receivedEvents;
+};
+
+class SlowSubscriber : public easy::Subscribe<EventThread>
+{
+public:
+    SlowSubscriber(easy::Notifier& notifier, std::chrono::milliseconds eventHandlingTime)
+        : easy::Subscribe<EventThread>{notifier}
+        , eventHandlingTime{eventHandlingTime}
+    {}
+    void onEvent(const EventThread&) { std::this_thread::sleep_for(eventHandlingTime); ++calledTimes; }
+
+public:
+    std::chrono::milliseconds eventHandlingTime;
+    unsigned calledTimes = 0;
+};
+
+class CountingSubscriber : public easy::Subscribe<EventThread>
+{
+public:
+    CountingSubscriber(easy::Notifier& notifier) : easy::Subscribe<EventThread>{notifier} {}
+    void onEvent(const EventThread&) { ++calledTimes; }
+
+public:
+    unsigned calledTimes = 0;
+};
+
+class PhraseEvent : public easy::Event<PhraseEvent>
+{
+public:
+    PhraseEvent(std::string phrase) : phrase{std::move(phrase)} {}
+    PhraseEvent(const PhraseEvent& other) : phrase{other.phrase} { ++copies; }
+    PhraseEvent(PhraseEvent&& other) : phrase{std::move(other.phrase)} { ++moves; }
+
+public:
+    std::string phrase;
+    static inline unsigned copies = 0;
+    static inline unsigned moves = 0;
+};
+
+class PhraseSubscriber : public easy::Subscribe<PhraseEvent>
+{
+public:
+    PhraseSubscriber(easy::Notifier& notifier) : easy::Subscribe<PhraseEvent>{notifier} {}
+    void onEvent(const PhraseEvent& event) { phrases.push_back(event.phrase); }
+    void answer(const std::string& phrase) { emplace<PhraseEvent>(phrase); }
+
+public:
+    std::vector<std::string> phrases;
+};
+
+class FrameEvent : public easy::Event<FrameEvent>
+{
+public:
+    FrameEvent(std::size_t size) : buffer{std::make_unique<std::vector<char>>(size)} {}
+
+public:
+    std::unique_ptr<std::vector<char>> buffer;
+};
+
+class FrameSubscriber : public easy::Subscribe<FrameEvent>
+{
+public:
+    FrameSubscriber(easy::Notifier& notifier) : easy::Subscribe<FrameEvent>{notifier} {}
+    void onEvent(const FrameEvent& event) { seenBuffer = event.buffer.get(); }
+    void onEvent(FrameEvent&& event) { ownedBuffer = std::move(event.buffer); }
+
+public:
+    const std::vector<char>* seenBuffer = nullptr;
+    std::unique_ptr<std::vector<char>> ownedBuffer;
+};
+
+class DestroyingSubscriber : public easy::Subscribe<EventThread>
+{
+public:
+    DestroyingSubscriber(easy::Notifier& notifier, std::unique_ptr<CountingSubscriber>& destroyed)
+        : easy::Subscribe<EventThread>{notifier}
+        , destroyed{destroyed}
+    {}
+    void onEvent(const EventThread&) { destroyed.reset(); ++calledTimes; }
+
+public:
+    std::unique_ptr<CountingSubscriber>& destroyed;
+    unsigned calledTimes = 0;
+};
+
+class StopEvent : public easy::Event<StopEvent, easy::Priority::High> {};
+class LogEvent : public easy::Event<LogEvent, easy::Priority::Low> {};
+
+class SensorReadEvent : public easy::Event<SensorReadEvent>
+{
+public:
+    static constexpr bool CONFLATING = true;
+
+    SensorReadEvent(unsigned sensor, int value) : sensor{sensor}, value{value} {}
+    Key_t conflationKey() const override { return sensor; }
+
+public:
+    unsigned sensor = {};
+    int value = {};
+};
+
+class SensorReadSubscriber : public easy::Subscribe<SensorReadEvent, EventThread>
+{
+public:
+    SensorReadSubscriber(easy::Notifier& notifier) : easy::Subscribe<SensorReadEvent, EventThread>{notifier} {}
+    template <typename... Filters>
+    SensorReadSubscriber(easy::Notifier& notifier, Filters&&... filters)
+        : easy::Subscribe<SensorReadEvent, EventThread>{notifier, std::forward<Filters>(filters)...}
+    {}
+    void onEvent(const SensorReadEvent& event) { readings.emplace_back(event.sensor, event.value); }
+    void onEvent(const EventThread&) { readings.emplace_back(0, 0); }
+
+public:
+    std::vector<std::pair<unsigned, int>> readings;
+};
+
+class DeviceEvent : public easy::Event<DeviceEvent>
+{
+public:
+    DeviceEvent(unsigned device) : device{device} {}
+    Key_t topic() const override { return device; }
+
+public:
+    unsigned device = {};
+};
+
+class DeviceSubscriber : public easy::Subscribe<easy::Topic<DeviceEvent>>
+{
+public:
+    DeviceSubscriber(easy::Notifier& notifier) : easy::Subscribe<easy::Topic<DeviceEvent>>{notifier} {}
+    void onEvent(const DeviceEvent& event) { devices.push_back(event.device); }
+
+public:
+    std::vector<unsigned> devices;
+};
+
+class AllDevicesSubscriber : public easy::Subscribe<DeviceEvent>
+{
+public:
+    AllDevicesSubscriber(easy::Notifier& notifier) : easy::Subscribe<DeviceEvent>{notifier} {}
+    void onEvent(const DeviceEvent& event) { devices.push_back(event.device); }
+
+public:
+    std::vector<unsigned> devices;
+};
+
+class PriorityRecordingSubscriber : public easy::Subscribe<EventThread, StopEvent, LogEvent>
+{
+public:
+    PriorityRecordingSubscriber(easy::Notifier& notifier)
+        : easy::Subscribe<EventThread, StopEvent, LogEvent>{notifier}
+    {}
+    void onEvent(const EventThread&) { receivedEvents.push_back(easy::Priority::Normal); }
+    void onEvent(const StopEvent&) { receivedEvents.push_back(easy::Priority::High); }
+    void onEvent(const LogEvent&) { receivedEvents.push_back(easy::Priority::Low); }
+
+public:
+    std::vector<easy::Priority> receivedEvents;
+};
+
 
 TEST_CASE("Nothing to dispatch if no event sent", "[single_thread][single_notifier]")
 {
@@ -322,4 +499,669 @@ TEST_CASE("Subscriber for multiple events will receive only those", "[single_thr
     REQUIRE_FALSE(notifier.dispatch());
 };
 
+TEST_CASE("Batch of events is dispatched in publish order", "[single_thread][multiple_notifiers][batch]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto sub = OrderRecordingSubscriber(notifier);
+
+    notifierBase.publishBatch(std::vector{EventThread(), EventThread(), EventThread()});
+    notifierBase.publishBatch(std::vector<std::variant<EventThread, EventThread2, EventThread3>>{
+        EventThread2(), EventThread3(), EventThread(), EventThread2()
+    });
+
+    while (notifier.dispatch());
+
+    REQUIRE(sub.receivedEvents == std::vector{1, 1, 1, 2, 1, 2});
+    REQUIRE_FALSE(notifierBase.dispatch());
+};
+
+TEST_CASE("Subscribers are notified in subscription order after unsubscription", "[single_thread][multiple_notifiers]")
+{
+    class IdSubscriber : public easy::Subscribe<EventThread>
+    {
+    public:
+        IdSubscriber(easy::Notifier& notifier, int id, std::vector<int>& notified)
+            : easy::Subscribe<EventThread>{notifier}
+            , id{id}
+            , notified{notified}
+        {}
+        void onEvent(const EventThread&) { notified.push_back(id); }
+
+    public:
+        int id;
+        std::vector<int>& notified;
+    };
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto notified = std::vector<int>{};
+    auto subs = std::vector<std::unique_ptr<IdSubscriber>>{};
+    for (auto id = 0; id < 5; ++id)
+        subs.push_back(std::make_unique<IdSubscriber>(notifier, id, notified));
+
+    subs[1].reset();
+    subs.push_back(std::make_unique<IdSubscriber>(notifier, 5, notified));
+    notifierBase.publish(EventThread());
+    notifier.dispatchAll();
+
+    REQUIRE(notified == std::vector{0, 2, 3, 4, 5});
+};
+
+TEST_CASE("Dispatch all delivers every queued event", "[single_thread][multiple_notifiers][dispatch]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    const auto EVENTS_RECEIVED_EXPECTED = 5u;
+
+    auto sub = MultiSubscriber(notifier, EVENTS_RECEIVED_EXPECTED);
+
+    notifierBase.publish(EventThread());
+    notifierBase.publish(EventThread4());
+    notifierBase.publish(EventThread2());
+    notifierBase.publish(EventThread2());
+    notifierBase.publish(EventThread3());
+    notifierBase.publish(EventThread());
+
+    REQUIRE(notifier.dispatchAll() == EVENTS_RECEIVED_EXPECTED);
+    REQUIRE(notifier.dispatchAll() == 0u);
+    REQUIRE_FALSE(notifier.dispatch());
+};
+
+TEST_CASE("Dispatch with limit delivers at most given number of events", "[single_thread][multiple_notifiers][dispatch]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    const auto EVENTS_RECEIVED_EXPECTED = 5u;
+
+    auto sub = MultiSubscriber(notifier, EVENTS_RECEIVED_EXPECTED);
+
+    for (auto i = 0u; i < EVENTS_RECEIVED_EXPECTED; ++i)
+        notifierBase.publish(EventThread());
+
+    REQUIRE(notifier.dispatch(0) == 0u);
+    REQUIRE(notifier.dispatch(2) == 2u);
+    REQUIRE(notifier.dispatch(2) == 2u);
+    REQUIRE(notifier.dispatch(2) == 1u);
+    REQUIRE(notifier.dispatch(2) == 0u);
+};
+
+TEST_CASE("Dispatch with wait delivers already queued events", "[single_thread][multiple_notifiers][dispatch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto sub = MultiSubscriber(notifier, 2);
+
+    notifierBase.publish(EventThread());
+    notifierBase.publish(EventThread2());
+
+    REQUIRE(notifier.dispatchWait(1000ms) == 2u);
+    REQUIRE(notifier.dispatchWait(1ms) == 0u);
+};
+
+TEST_CASE("Dispatch for duration stops delivering events after deadline", "[single_thread][multiple_notifiers][dispatch]")
+{
+    using std::literals::chrono_literals::operator""ms;
+    using std::literals::chrono_literals::operator""s;
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    const auto EVENTS_SENT = 4 * easy::Notifier::DEADLINE_CHECK_INTERVAL;
+
+    auto sub = SlowSubscriber(notifier, 1ms);
+
+    for (auto i = 0u; i < EVENTS_SENT; ++i)
+        notifierBase.publish(EventThread());
+
+    const auto dispatched = notifier.dispatchFor(1ms);
+    REQUIRE(dispatched <= easy::Notifier::DEADLINE_CHECK_INTERVAL);
+    REQUIRE(sub.calledTimes == dispatched);
+
+    REQUIRE(notifier.dispatchUntil(std::chrono::system_clock::now() - 1ms) == 0u);
+    REQUIRE(notifier.dispatchUntil(std::chrono::steady_clock::now() + 10s) == EVENTS_SENT - dispatched);
+    REQUIRE(sub.calledTimes == EVENTS_SENT);
+};
+
+TEST_CASE("Notifier queue limit drops newest events", "[single_thread][multiple_notifiers][queue_limit]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier(easy::QueueLimit{2, easy::OverflowPolicy::DropNewest});
+
+    auto sub = OrderRecordingSubscriber(notifier);
+
+    REQUIRE(notifierBase.publish(EventThread()) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(EventThread()) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(EventThread2()) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(EventThread2()) == easy::PublishStatus::Ok);
+
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE(sub.receivedEvents == std::vector{1, 1});
+    REQUIRE(notifier.droppedEvents() == 2u);
+};
+
+TEST_CASE("Notifier queue limit drops oldest events", "[single_thread][multiple_notifiers][queue_limit]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier(easy::QueueLimit{2, easy::OverflowPolicy::DropOldest});
+
+    auto sub = OrderRecordingSubscriber(notifier);
+
+    notifierBase.publish(EventThread());
+    notifierBase.publish(EventThread());
+    notifierBase.publish(EventThread2());
+    notifierBase.publish(EventThread2());
+
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE(sub.receivedEvents == std::vector{2, 2});
+    REQUIRE(notifier.droppedEvents() == 2u);
+};
+
+TEST_CASE("Notifier queue limit fails publish when full", "[single_thread][multiple_notifiers][queue_limit]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier(easy::QueueLimit{1, easy::OverflowPolicy::Fail});
+    easy::Notifier unlimitedNotifier;
+
+    auto sub = OrderRecordingSubscriber(notifier);
+    auto sub2 = OrderRecordingSubscriber(unlimitedNotifier);
+
+    REQUIRE(notifierBase.publish(EventThread()) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(EventThread2()) == easy::PublishStatus::QueueFull);
+
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(unlimitedNotifier.dispatchAll() == 2u);
+    REQUIRE(notifier.droppedEvents() == 1u);
+    REQUIRE(unlimitedNotifier.droppedEvents() == 0u);
+
+    REQUIRE(notifierBase.publish(EventThread2()) == easy::PublishStatus::Ok);
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.receivedEvents == std::vector{1, 2});
+};
+
+TEST_CASE("Notifier queue can not block publisher", "[single_thread][single_notifier][queue_limit]")
+{
+    REQUIRE_THROWS_AS(easy::Notifier(easy::QueueLimit{1, easy::OverflowPolicy::Block}), std::invalid_argument);
+};
+
+TEST_CASE("Emplaced event is constructed in place", "[single_thread][multiple_notifiers]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto subBase = PhraseSubscriber(notifierBase);
+    auto sub = PhraseSubscriber(notifier);
+
+    PhraseEvent::copies = 0;
+    PhraseEvent::moves = 0;
+    notifierBase.emplace<PhraseEvent>("question");
+    sub.answer("answer");
+
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(notifierBase.dispatchAll() == 1u);
+    REQUIRE(sub.phrases == std::vector<std::string>{"question"});
+    REQUIRE(subBase.phrases == std::vector<std::string>{"answer"});
+    REQUIRE(PhraseEvent::copies == 0u);
+    REQUIRE(PhraseEvent::moves == 0u);
+
+    notifierBase.publish(PhraseEvent("moved"));
+    REQUIRE(PhraseEvent::moves == 1u);
+};
+
+TEST_CASE("Last subscriber takes ownership of exclusive event", "[single_thread][multiple_notifiers]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = FrameSubscriber(notifier);
+    auto sub2 = FrameSubscriber(notifier);
+
+    auto frame = FrameEvent(1024);
+    const auto buffer = frame.buffer.get();
+    notifierBase.publish(std::move(frame));
+
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.seenBuffer == buffer);
+    REQUIRE_FALSE(sub.ownedBuffer);
+    REQUIRE(sub2.seenBuffer == nullptr);
+    REQUIRE(sub2.ownedBuffer.get() == buffer);
+};
+
+TEST_CASE("Event queued by other notifiers is taken only by the last one", "[single_thread][multiple_notifiers]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    easy::Notifier notifier2;
+    auto sub = FrameSubscriber(notifier);
+    auto sub2 = FrameSubscriber(notifier2);
+
+    notifierBase.emplace<FrameEvent>(1024);
+
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.seenBuffer);
+    REQUIRE_FALSE(sub.ownedBuffer);
+
+    REQUIRE(notifier2.dispatchAll() == 1u);
+    REQUIRE(sub2.ownedBuffer.get() == sub.seenBuffer);
+};
+
+TEST_CASE("Subscriber destroyed during dispatch is not notified", "[single_thread][multiple_notifiers]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+
+    auto destroyed = std::unique_ptr<CountingSubscriber>{};
+    auto sub = DestroyingSubscriber(notifier, destroyed);
+    destroyed = std::make_unique<CountingSubscriber>(notifier);
+    auto sub2 = CountingSubscriber(notifier);
+
+    notifierBase.publish(EventThread());
+    notifierBase.publish(EventThread());
+
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE_FALSE(destroyed);
+    REQUIRE(sub.calledTimes == 2u);
+    REQUIRE(sub2.calledTimes == 2u);
+};
+
+TEST_CASE("Events of higher priority are dispatched first", "[single_thread][multiple_notifiers][priority]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = PriorityRecordingSubscriber(notifier);
+
+    notifierBase.publish(LogEvent());
+    for (auto i = 0; i < 100; ++i)
+        notifierBase.publish(EventThread());
+    notifierBase.publish(StopEvent());
+    notifierBase.publish(StopEvent());
+
+    REQUIRE(notifier.dispatch(2) == 2u);
+    REQUIRE(sub.receivedEvents == std::vector{easy::Priority::High, easy::Priority::High});
+
+    REQUIRE(notifier.dispatchAll() == 101u);
+    REQUIRE(sub.receivedEvents[2] == easy::Priority::Normal);
+    REQUIRE(sub.receivedEvents.back() == easy::Priority::Low);
+};
+
+TEST_CASE("Notifier queue limit drops events of lower priority first", "[single_thread][multiple_notifiers][queue_limit][priority]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier(easy::QueueLimit{2, easy::OverflowPolicy::DropOldest});
+    auto sub = PriorityRecordingSubscriber(notifier);
+
+    notifierBase.publish(StopEvent());
+    notifierBase.publish(LogEvent());
+    notifierBase.publish(EventThread());    // drops queued log
+    notifierBase.publish(EventThread());    // drops the older data event
+    notifierBase.publish(LogEvent());       // dropped, queued events are more important
+
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE(sub.receivedEvents == std::vector{easy::Priority::High, easy::Priority::Normal});
+    REQUIRE(notifier.droppedEvents() == 3u);
+};
+
+TEST_CASE("Queued conflating event is replaced by the latest one of the same key", "[single_thread][multiple_notifiers][conflation]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = SensorReadSubscriber(notifier);
+
+    for (auto value = 1; value <= 100; ++value)
+    {
+        notifierBase.publish(SensorReadEvent(1, value));
+        notifierBase.publish(SensorReadEvent(2, -value));
+        if (value == 50)
+            notifierBase.publish(EventThread());
+    }
+
+    REQUIRE(notifier.dispatchAll() == 3u);
+    REQUIRE(sub.readings == std::vector<std::pair<unsigned, int>>{{1, 100}, {2, -100}, {0, 0}});
+
+    notifierBase.publish(SensorReadEvent(1, 101));
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.readings.back() == std::pair<unsigned, int>{1, 101});
+};
+
+TEST_CASE("Conflating event replaces pending one in full queue", "[single_thread][multiple_notifiers][conflation][queue_limit]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier(easy::QueueLimit{2, easy::OverflowPolicy::Fail});
+    auto sub = SensorReadSubscriber(notifier);
+
+    REQUIRE(notifierBase.publish(SensorReadEvent(1, 1)) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(EventThread()) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(SensorReadEvent(1, 2)) == easy::PublishStatus::Ok);
+    REQUIRE(notifierBase.publish(SensorReadEvent(2, 1)) == easy::PublishStatus::QueueFull);
+
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE(sub.readings == std::vector<std::pair<unsigned, int>>{{1, 2}, {0, 0}});
+    REQUIRE(notifier.droppedEvents() == 1u);
+};
+
+TEST_CASE("Filtered subscriber receives only accepted events", "[single_thread][multiple_notifiers][filter]")
+{
+    auto isFirstSensor = [](const SensorReadEvent& event) { return event.sensor == 1; };
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    easy::Notifier filteredNotifier;
+    auto sub = SensorReadSubscriber(notifier, isFirstSensor, nullptr);
+    auto sub2 = SensorReadSubscriber(notifier);
+    auto filteredSub = SensorReadSubscriber(filteredNotifier, isFirstSensor, [](const EventThread&) { return false; });
+
+    notifierBase.publish(SensorReadEvent(1, 1));
+    notifierBase.publish(SensorReadEvent(2, 1));
+    notifierBase.publish(EventThread());
+
+    REQUIRE(notifier.dispatchAll() == 3u);
+    REQUIRE(sub.readings == std::vector<std::pair<unsigned, int>>{{1, 1}, {0, 0}});
+    REQUIRE(sub2.readings == std::vector<std::pair<unsigned, int>>{{1, 1}, {2, 1}, {0, 0}});
+
+    REQUIRE(filteredNotifier.dispatchAll() == 1u);
+    REQUIRE(filteredSub.readings == std::vector<std::pair<unsigned, int>>{{1, 1}});
+};
+
+TEST_CASE("Topic subscriber receives only events of its topics", "[single_thread][multiple_notifiers][topic]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    easy::Notifier topicNotifier;
+    auto sub = DeviceSubscriber(notifier);
+    auto sub2 = AllDevicesSubscriber(notifier);
+    auto topicSub = DeviceSubscriber(topicNotifier);
+    auto topicSub2 = DeviceSubscriber(topicNotifier);
+
+    sub.subscribeTopic<DeviceEvent>(1);
+    topicSub.subscribeTopic<DeviceEvent>(1);
+    topicSub.subscribeTopic<DeviceEvent>(3);
+    topicSub2.subscribeTopic<DeviceEvent>(3);
+
+    for (auto device = 0u; device < 5; ++device)
+        notifierBase.publish(DeviceEvent(device));
+
+    REQUIRE(notifier.dispatchAll() == 5u);
+    REQUIRE(sub.devices == std::vector{1u});
+    REQUIRE(sub2.devices == std::vector{0u, 1u, 2u, 3u, 4u});
+
+    REQUIRE(topicNotifier.dispatchAll() == 2u);
+    REQUIRE(topicSub.devices == std::vector{1u, 3u});
+    REQUIRE(topicSub2.devices == std::vector{3u});
+
+    topicSub.unsubscribeTopic<DeviceEvent>(1);
+    topicSub.unsubscribeTopic<DeviceEvent>(3);
+    topicSub.subscribeTopic<DeviceEvent>(4);
+    notifierBase.publish(DeviceEvent(1));
+    notifierBase.publish(DeviceEvent(4));
+    REQUIRE(topicNotifier.dispatchAll() == 1u);
+    REQUIRE(topicSub.devices == std::vector{1u, 3u, 4u});
+};
+
+TEST_CASE("Topics subscribed in the same notifier are not delivered twice", "[single_thread][multiple_notifiers][topic]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    easy::Notifier notifier2;
+    auto sub = DeviceSubscriber(notifier);
+    auto sub2 = AllDevicesSubscriber(notifier);
+    auto sub3 = DeviceSubscriber(notifier2);
+    sub.subscribeTopic<DeviceEvent>(1);
+    sub3.subscribeTopic<DeviceEvent>(1);
+
+    notifierBase.publish(DeviceEvent(1));
+    notifierBase.publish(DeviceEvent(2));
+    notifier2.publish(DeviceEvent(1));    // not delivered to its own notifier
+
+    REQUIRE(notifier.dispatchAll() == 3u);
+    REQUIRE(sub.devices == std::vector{1u, 1u});
+    REQUIRE(sub2.devices == std::vector{1u, 2u, 1u});
+    REQUIRE(notifier2.dispatchAll() == 1u);
+    REQUIRE(sub3.devices == std::vector{1u});
+};
+
+TEST_CASE("Delayed event is published by dispatch after the delay", "[single_thread][multiple_notifiers][timer]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = AllDevicesSubscriber(notifier);
+
+    notifierBase.publishAfter(std::chrono::milliseconds(100), DeviceEvent(2));
+    notifierBase.publishAt(std::chrono::steady_clock::now() + std::chrono::milliseconds(50), DeviceEvent(1));
+    notifierBase.publishAfter(std::chrono::milliseconds(0), DeviceEvent(0));
+    REQUIRE(notifier.dispatchAll() == 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));    // delays are rounded up to milliseconds
+    notifierBase.dispatchAll();
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.devices == std::vector{0u});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    notifierBase.dispatchAll();
+    REQUIRE(notifier.dispatchAll() == 2u);
+    REQUIRE(sub.devices == std::vector{0u, 1u, 2u});
+};
+
+TEST_CASE("Cancelled delayed event is not published", "[single_thread][multiple_notifiers][timer]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = AllDevicesSubscriber(notifier);
+
+    auto timer = notifierBase.publishAfter(std::chrono::milliseconds(5), DeviceEvent(1));
+    auto timer2 = notifierBase.publishAfter(std::chrono::milliseconds(5), DeviceEvent(2));
+    REQUIRE(notifierBase.cancel(timer));
+    REQUIRE_FALSE(notifierBase.cancel(timer));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    notifierBase.dispatchAll();
+    REQUIRE_FALSE(notifierBase.cancel(timer2));
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.devices == std::vector{2u});
+};
+
+TEST_CASE("Waiting notifier publishes its delayed events", "[single_thread][multiple_notifiers][timer]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = AllDevicesSubscriber(notifier);
+
+    notifierBase.publishAfter(std::chrono::milliseconds(10), DeviceEvent(1));
+    REQUIRE(notifierBase.dispatchWait(std::chrono::milliseconds(50)) == 0u);
+
+    REQUIRE(notifier.dispatchAll() == 1u);
+    REQUIRE(sub.devices == std::vector{1u});
+};
+
+TEST_CASE("Periodic events are published every interval until cancelled", "[single_thread][multiple_notifiers][timer]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = AllDevicesSubscriber(notifier);
+
+    auto device = 0u;
+    auto nextDevice = [&device]() { return DeviceEvent(device++); };
+    const auto start = std::chrono::steady_clock::now();
+    auto timer = notifierBase.publishEvery(std::chrono::milliseconds(10), nextDevice);
+    while (sub.devices.size() < 3)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        notifierBase.dispatchAll();
+        notifier.dispatchAll();
+    }
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+    REQUIRE(sub.devices == std::vector{0u, 1u, 2u});
+
+    REQUIRE(notifierBase.cancel(timer));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    notifierBase.dispatchAll();
+    REQUIRE(notifier.dispatchAll() == 0u);
+    REQUIRE(sub.devices.size() == 3u);
+
+    REQUIRE_THROWS_AS(notifierBase.publishEvery(std::chrono::milliseconds(0), []() { return DeviceEvent(0); }),
+                      std::invalid_argument);
+};
+
+TEST_CASE("Periodic events missed by late dispatch are not published in a burst", "[single_thread][multiple_notifiers][timer]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = AllDevicesSubscriber(notifier);
+
+    notifierBase.publishEvery(std::chrono::milliseconds(5), []() { return DeviceEvent(1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    notifierBase.dispatchAll();
+    REQUIRE(notifier.dispatchAll() == 1u);
+};
+
+TEST_CASE("Topics benchmark", "[single_thread][multiple_notifiers][topic][benchmark]")
+{
+    const auto TOPICS = 10000u;
+
+    class FilteredDevicesSubscriber : public easy::Subscribe<DeviceEvent>
+    {
+    public:
+        FilteredDevicesSubscriber(easy::Notifier& notifier, unsigned device)
+            : easy::Subscribe<DeviceEvent>{notifier, [device](const DeviceEvent& event) { return event.device == device; }}
+        {}
+        void onEvent(const DeviceEvent&) { ++calledTimes; }
+
+    public:
+        unsigned calledTimes = 0;
+    };
+
+    BENCHMARK_ADVANCED("10000 topics subscribed")(Catch::Benchmark::Chronometer meter) {
+        easy::Notifier notifierBase;
+        easy::Notifier notifier;
+        auto subscribers = std::vector<std::unique_ptr<DeviceSubscriber>>{};
+        for (auto device = 0u; device < TOPICS; ++device)
+        {
+            subscribers.push_back(std::make_unique<DeviceSubscriber>(notifier));
+            subscribers.back()->subscribeTopic<DeviceEvent>(device);
+        }
+
+        auto device = 0u;
+        meter.measure([&] {
+            notifierBase.publish(DeviceEvent(++device % TOPICS));
+            return notifier.dispatch();
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 filtered subscribers")(Catch::Benchmark::Chronometer meter) {
+        easy::Notifier notifierBase;
+        easy::Notifier notifier;
+        auto subscribers = std::vector<std::unique_ptr<FilteredDevicesSubscriber>>{};
+        for (auto device = 0u; device < TOPICS; ++device)
+            subscribers.push_back(std::make_unique<FilteredDevicesSubscriber>(notifier, device));
+
+        auto device = 0u;
+        meter.measure([&] {
+            notifierBase.publish(DeviceEvent(++device % TOPICS));
+            return notifier.dispatch();
+        });
+    };
+};
+
+TEST_CASE("Dispatch fan-out benchmark", "[single_thread][multiple_notifiers][benchmark]")
+{
+    auto benchmarkFanOut = [](Catch::Benchmark::Chronometer& meter, std::size_t subscribersCount) {
+        easy::Notifier notifierBase;
+        easy::Notifier notifier;
+
+        auto subscribers = std::vector<std::unique_ptr<CountingSubscriber>>{};
+        for (auto i = 0u; i < subscribersCount; ++i)
+            subscribers.push_back(std::make_unique<CountingSubscriber>(notifier));
+
+        meter.measure([&notifierBase, &notifier] {
+            notifierBase.publish(EventThread());
+            return notifier.dispatch();
+        });
+    };
+
+    BENCHMARK_ADVANCED("1 Subscriber per event")(Catch::Benchmark::Chronometer meter) {
+        benchmarkFanOut(meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("10 Subscribers per event")(Catch::Benchmark::Chronometer meter) {
+        benchmarkFanOut(meter, 10);
+    };
+
+    BENCHMARK_ADVANCED("1000 Subscribers per event")(Catch::Benchmark::Chronometer meter) {
+        benchmarkFanOut(meter, 1000);
+    };
+};
+
+
+class DeepEventBase : public easy::Event<DeepEventBase>
+{
+public:
+    virtual ~DeepEventBase() = default;
+    virtual int value() const { return 1; }
+};
+
+class DeepEventLevel1 : public DeepEventBase { public: int value() const override { return 2; } };
+class DeepEventLevel2 : public DeepEventLevel1 { public: int value() const override { return 3; } };
+class DeepEvent : public DeepEventLevel2 { public: int value() const override { return 4; } };
+
+class DeepEventSubscriber : public easy::Subscribe<DeepEventBase>
+{
+public:
+    DeepEventSubscriber(easy::Notifier& notifier) : easy::Subscribe<DeepEventBase>{notifier} {}
+    void onEvent(const DeepEventBase& event) { sum += event.value(); }
+
+public:
+    long long sum = 0;
+};
+
+TEST_CASE("Subscriber of base event receives derived events", "[single_thread][multiple_notifiers]")
+{
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = DeepEventSubscriber(notifier);
+
+    notifierBase.publish(DeepEventBase());
+    notifierBase.publish(DeepEventLevel1());
+    notifierBase.publish(DeepEvent());
+    REQUIRE(notifier.dispatchAll() == 3u);
+    REQUIRE(sub.sum == 1 + 2 + 4);
+};
+
+TEST_CASE("Event delivery benchmark", "[single_thread][multiple_notifiers][benchmark]")
+{
+    const auto EVENTS_SENT = 1000;
+
+    auto event = std::make_shared<DeepEvent>();
+    const easy::IEvent& deliveredEvent = *event;    // subscriber of the base type receives derived event
+
+    BENCHMARK("Downcast with dynamic_cast (previous delivery) | 1000 events")
+    {
+        auto sum = 0;
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+            sum += dynamic_cast<const DeepEventBase&>(deliveredEvent).value();
+        return sum;
+    };
+
+    BENCHMARK("Downcast with static_cast (current delivery) | 1000 events")
+    {
+        auto sum = 0;
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+            sum += static_cast<const DeepEventBase&>(deliveredEvent).value();
+        return sum;
+    };
+
+    easy::Notifier notifierBase;
+    easy::Notifier notifier;
+    auto sub = DeepEventSubscriber(notifier);
+
+    BENCHMARK("Publish and dispatch | 1000 events")
+    {
+        for (auto i = 0; i < EVENTS_SENT; ++i)
+            notifierBase.publish(DeepEvent());
+        return notifier.dispatchAll();
+    };
+};
+
 }  // namespace single_thread
@@ -0,0 +1,108 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/slotmap.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+
+TEST_CASE("Slot map is empty on initialization", "[slot_map]")
+{
+    auto slots = easy::SlotMap<int>{};
+    REQUIRE(slots.empty());
+    REQUIRE(slots.begin() == slots.end());
+    REQUIRE_FALSE(slots.contains({}));
+};
+
+TEST_CASE("Slot map finds inserted values by handle", "[slot_map]")
+{
+    auto slots = easy::SlotMap<int>{};
+    auto handles = std::vector<easy::SlotMap<int>::Handle>{};
+    for (auto value = 0; value < 10; ++value)
+        handles.push_back(slots.insert(value));
+
+    REQUIRE(slots.size() == 10u);
+    for (auto value = 0; value < 10; ++value)
+    {
+        REQUIRE(slots.contains(handles[value]));
+        REQUIRE(*slots.find(handles[value]) == value);
+    }
+};
+
+TEST_CASE("Slot map removes values and keeps others reachable", "[slot_map]")
+{
+    struct Parameters
+    {
+        std::vector<int> insert;
+        std::vector<int> erase;
+        std::vector<int> expected;
+    };
+
+    auto params = std::vector{
+        Parameters{{5}, {}, {5}},
+        Parameters{{2, 3}, {}, {5, 2, 3}},
+        Parameters{{1, 7, 4}, {}, {5, 2, 3, 1, 7, 4}},
+        Parameters{{}, {2}, {5, 3, 1, 7, 4}},
+        Parameters{{}, {5, 4}, {3, 1, 7}},
+        Parameters{{}, {3, 1}, {7}},
+        Parameters{{}, {7}, {}},
+        Parameters{{1, 2, 7}, {}, {1, 2, 7}},
+        Parameters{{}, {7}, {1, 2}},
+        Parameters{{}, {1, 2}, {}}
+    };
+
+    auto slots = easy::SlotMap<int>{};
+    auto handles = std::unordered_map<int, easy::SlotMap<int>::Handle>{};
+
+    for (const auto& param : params)
+    {
+        for (const auto& value : param.insert)
+            handles[value] = slots.insert(value);
+
+        for (const auto& value : param.erase)
+        {
+            REQUIRE(slots.erase(handles[value]));
+            REQUIRE_FALSE(slots.contains(handles[value]));
+        }
+
+        auto values = std::vector<int>(slots.begin(), slots.end());
+        auto expected = param.expected;
+        std::sort(values.begin(), values.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(values == expected);
+
+        for (const auto& value : param.expected)
+            REQUIRE(*slots.find(handles[value]) == value);
+    }
+};
+
+TEST_CASE("Slot map keeps insertion order on ordered erase", "[slot_map]")
+{
+    auto slots = easy::SlotMap<int>{};
+    auto handles = std::vector<easy::SlotMap<int>::Handle>{};
+    for (auto value = 0; value < 6; ++value)
+        handles.push_back(slots.insert(value));
+
+    REQUIRE(slots.eraseOrdered(handles[1]));
+    REQUIRE(slots.eraseOrdered(handles[4]));
+    REQUIRE_FALSE(slots.eraseOrdered(handles[4]));
+    handles.push_back(slots.insert(6));
+
+    REQUIRE(std::vector<int>(slots.begin(), slots.end()) == std::vector{0, 2, 3, 5, 6});
+    for (auto value : {0, 2, 3, 5, 6})
+        REQUIRE(*slots.find(handles[value]) == value);
+};
+
+TEST_CASE("Slot map does not accept stale handles of reused slots", "[slot_map]")
+{
+    auto slots = easy::SlotMap<int>{};
+    auto handle = slots.insert(1);
+    REQUIRE(slots.erase(handle));
+
+    auto reusedHandle = slots.insert(2);
+    REQUIRE(reusedHandle.index == handle.index);
+    REQUIRE_FALSE(slots.contains(handle));
+    REQUIRE(slots.find(handle) == nullptr);
+    REQUIRE_FALSE(slots.erase(handle));
+    REQUIRE(*slots.find(reusedHandle) == 2);
+};
@@ -0,0 +1,149 @@
+#include "catch2/catch_amalgamated.hpp"
+#include "easy/timerwheel.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+TEST_CASE("Timer wheel passes values due at advanced tick", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto expired = std::vector<int>{};
+    auto collect = [&expired](int value) { expired.push_back(value); };
+
+    timers.insert(5, 5);
+    timers.insert(1, 1);
+    timers.insert(300, 300);
+    REQUIRE(timers.size() == 3u);
+
+    REQUIRE(timers.advance(4, collect) == 1u);
+    REQUIRE(expired == std::vector{1});
+    REQUIRE(timers.advance(299, collect) == 1u);
+    REQUIRE(expired == std::vector{1, 5});
+    REQUIRE(timers.advance(300, collect) == 1u);
+    REQUIRE(expired == std::vector{1, 5, 300});
+    REQUIRE(timers.empty());
+};
+
+TEST_CASE("Timer wheel passes past values on next advance", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto expired = std::vector<int>{};
+    timers.advance(100, [](int) {});
+    REQUIRE(timers.currentTick() == 100u);
+
+    timers.insert(10, 10);
+    REQUIRE(timers.nextExpiry() == 101u);
+    REQUIRE(timers.advance(101, [&expired](int value) { expired.push_back(value); }) == 1u);
+    REQUIRE(expired == std::vector{10});
+};
+
+TEST_CASE("Timer wheel does not pass cancelled values", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto expired = std::vector<int>{};
+    auto first = timers.insert(10, 1);
+    auto second = timers.insert(10, 2);
+    auto third = timers.insert(70000, 3);
+
+    REQUIRE(timers.cancel(second));
+    REQUIRE(timers.cancel(third));
+    REQUIRE_FALSE(timers.cancel(third));
+    REQUIRE(timers.size() == 1u);
+
+    timers.advance(100000, [&expired](int value) { expired.push_back(value); });
+    REQUIRE(expired == std::vector{1});
+    REQUIRE_FALSE(timers.cancel(first));
+};
+
+TEST_CASE("Timer wheel next expiry is not later than the earliest value", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    REQUIRE_FALSE(timers.nextExpiry());
+
+    timers.insert(1000, 1000);
+    REQUIRE(timers.nextExpiry() == 256u);
+    timers.insert(20, 20);
+    REQUIRE(timers.nextExpiry() == 20u);
+};
+
+TEST_CASE("Timer wheel passes random values in order of expiry", "[timer_wheel]")
+{
+    const auto TIMERS = 10000;
+
+    auto random = std::mt19937_64{42};
+    auto timers = easy::TimerWheel<uint64_t>{};
+    auto cancelled = std::vector<bool>{};
+    auto handles = std::vector<easy::TimerWheel<uint64_t>::Handle>{};
+    for (auto i = 0; i < TIMERS; ++i)
+    {
+        const auto expiry = random() % (uint64_t{1} << (8 * (i % 5 + 1)));    // every level and beyond the top
+        handles.push_back(timers.insert(expiry, expiry));
+    }
+    for (auto i = 0; i < TIMERS; i += 7)
+        timers.cancel(handles[i]);
+
+    auto expected = timers.size();
+    auto lastTick = uint64_t{};
+    auto isOrdered = true;
+    auto now = uint64_t{};
+    while (!timers.empty())
+    {
+        now = timers.nextExpiry().value();
+        expected -= timers.advance(now, [&](uint64_t expiry) {
+            isOrdered = isOrdered && expiry <= now && expiry + 1 >= lastTick;
+            lastTick = now;
+        });
+    }
+    REQUIRE(isOrdered);
+    REQUIRE(expected == 0u);
+};
+
+TEST_CASE("Timer wheel passes periodic values at fixed rate", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto ticks = std::vector<uint64_t>{};
+    auto handle = timers.insert(10, 0, 10);
+
+    auto collect = [&](int) { ticks.push_back(timers.currentTick()); };
+    for (auto now = 5u; now < 40; now += 7)
+        timers.advance(now, collect);
+    REQUIRE(ticks == std::vector<uint64_t>{10, 20, 30});    // late advances do not shift the schedule
+    REQUIRE(timers.nextExpiry() == 40u);
+
+    REQUIRE(timers.size() == 1u);
+    REQUIRE(timers.cancel(handle));
+    REQUIRE(timers.empty());
+};
+
+TEST_CASE("Timer wheel skips periods missed between advances", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto passed = 0;
+    timers.insert(10, 0, 10);
+
+    REQUIRE(timers.advance(1005, [&passed](int) { ++passed; }) == 1u);
+    REQUIRE(timers.nextExpiry() == 1010u);
+    REQUIRE(timers.advance(1010, [&passed](int) { ++passed; }) == 1u);
+    REQUIRE(passed == 2);
+};
+
+TEST_CASE("Timer wheel allows periodic value to cancel itself", "[timer_wheel]")
+{
+    auto timers = easy::TimerWheel<int>{};
+    auto passed = 0;
+    auto handle = easy::TimerWheel<int>::Handle{};
+    handle = timers.insert(10, 0, 10);
+
+    for (auto now = 10u; now <= 100; now += 10)
+    {
+        timers.advance(now, [&](int) {
+            if (++passed == 3)
+                REQUIRE(timers.cancel(handle));
+        });
+    }
+    REQUIRE(passed == 3);
+    REQUIRE(timers.empty());
+    REQUIRE_FALSE(timers.cancel(handle));
+};